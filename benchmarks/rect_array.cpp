@@ -0,0 +1,187 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+// compares the rect_array queries against looping over a vector of rect
+// and testing them one by one, the results are checked to be the same
+//
+// usage: rect_array [rectangles] [queries]
+
+#include <gum/spatial/rect_array.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+using clock_type = std::chrono::steady_clock;
+
+const char* simd_name() {
+    switch(sdl::detail::simd()) {
+    case sdl::detail::simd_level::avx2:
+        return "avx2";
+    case sdl::detail::simd_level::sse41:
+        return "sse4.1";
+    default:
+        return "scalar";
+    }
+}
+
+// nanoseconds per query
+template<typename Function>
+double time_queries(int queries, Function f) {
+    auto start = clock_type::now();
+    for(int i = 0; i < queries; ++i) {
+        f(i);
+    }
+    std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+    return elapsed.count() / queries;
+}
+
+void report(const char* name, double looped, double batched, bool same) {
+    std::printf("%-14s %10.1f ns %10.1f ns %8.2fx%s\n", name, looped, batched, looped / batched,
+                same ? "" : "  (results differ!)");
+}
+
+void set_bit(std::vector<uint64_t>& mask, std::size_t i) {
+    mask[i / 64] |= uint64_t(1) << (i % 64);
+}
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    // atoi gives 0 for anything unparseable, at least one query is needed to divide by
+    auto count = std::max(argc > 1 ? std::atoi(argv[1]) : 10000, 1);
+    auto queries = std::max(argc > 2 ? std::atoi(argv[2]) : 2000, 1);
+
+    // a 4096x4096 world with a few empty rectangles thrown in
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> position(0, 4096);
+    std::uniform_int_distribution<int> size(-4, 64);
+    std::vector<sdl::rect> rects;
+    sdl::rect_array array;
+    array.reserve(static_cast<std::size_t>(count));
+    for(int i = 0; i < count; ++i) {
+        sdl::rect r(position(rng), position(rng), size(rng), size(rng));
+        rects.push_back(r);
+        array.push_back(r);
+    }
+
+    std::vector<sdl::rect> areas;
+    std::vector<SDL_Point> points;
+    std::uniform_int_distribution<int> extent(16, 512);
+    for(int i = 0; i < queries; ++i) {
+        areas.emplace_back(position(rng), position(rng), extent(rng), extent(rng));
+        points.push_back(SDL_Point{ position(rng), position(rng) });
+    }
+
+    auto words = (rects.size() + 63) / 64;
+    std::vector<uint64_t> expected(words);
+    std::vector<uint64_t> mask;
+    std::size_t checksum = 0;
+    bool same = true;
+
+    std::printf("%d rectangles, %d queries, %s\n", count, queries, simd_name());
+    std::printf("%-14s %13s %13s %9s\n", "", "looped", "rect_array", "speedup");
+
+    auto looped = time_queries(queries, [&](int q) {
+        expected.assign(words, 0);
+        for(std::size_t i = 0; i < rects.size(); ++i) {
+            if(rects[i].intersects(areas[q])) {
+                set_bit(expected, i);
+            }
+        }
+        checksum += expected[0];
+    });
+    auto batched = time_queries(queries, [&](int q) {
+        array.intersects(areas[q], mask);
+        checksum += mask[0];
+    });
+    for(int q = 0; q < queries && same; ++q) {
+        expected.assign(words, 0);
+        for(std::size_t i = 0; i < rects.size(); ++i) {
+            if(rects[i].intersects(areas[q])) {
+                set_bit(expected, i);
+            }
+        }
+        array.intersects(areas[q], mask);
+        same = std::equal(expected.begin(), expected.end(), mask.begin());
+    }
+    report("intersects", looped, batched, same);
+
+    looped = time_queries(queries, [&](int q) {
+        expected.assign(words, 0);
+        for(std::size_t i = 0; i < rects.size(); ++i) {
+            if(rects[i].contains(points[q])) {
+                set_bit(expected, i);
+            }
+        }
+        checksum += expected[0];
+    });
+    batched = time_queries(queries, [&](int q) {
+        array.contains(points[q].x, points[q].y, mask);
+        checksum += mask[0];
+    });
+    same = true;
+    for(int q = 0; q < queries && same; ++q) {
+        expected.assign(words, 0);
+        for(std::size_t i = 0; i < rects.size(); ++i) {
+            if(rects[i].contains(points[q])) {
+                set_bit(expected, i);
+            }
+        }
+        array.contains(points[q].x, points[q].y, mask);
+        same = std::equal(expected.begin(), expected.end(), mask.begin());
+    }
+    report("contains", looped, batched, same);
+
+    std::size_t looped_hits = 0;
+    std::size_t batched_hits = 0;
+    looped = time_queries(queries, [&](int q) {
+        for(auto&& r : rects) {
+            if(r.contains(points[q])) {
+                ++looped_hits;
+                break;
+            }
+        }
+    });
+    batched = time_queries(queries, [&](int q) {
+        batched_hits += array.contains_any(points[q].x, points[q].y);
+    });
+    report("contains_any", looped, batched, looped_hits == batched_hits);
+
+    sdl::rect looped_bounds;
+    sdl::rect batched_bounds;
+    looped = time_queries(queries, [&](int) {
+        looped_bounds = sdl::rect();
+        for(auto&& r : rects) {
+            looped_bounds = looped_bounds.union_with(r);
+        }
+        checksum += static_cast<std::size_t>(looped_bounds.w);
+    });
+    batched = time_queries(queries, [&](int) {
+        batched_bounds = array.bounds();
+        checksum += static_cast<std::size_t>(batched_bounds.w);
+    });
+    report("bounds", looped, batched, looped_bounds == batched_bounds);
+
+    // keeps the loops from being optimised away
+    std::printf("checksum %zu\n", checksum);
+    return 0;
+}
@@ -0,0 +1,120 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+// compares drawing sprites one by one against a sprite_batch on the
+// software renderer, which needs no window or GPU to run
+//
+// usage: sprite_batch [sprites] [frames]
+
+#include <gum/video/sprite.hpp>
+#include <gum/video/sprite_batch.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+using clock_type = std::chrono::steady_clock;
+
+// milliseconds per frame, the flush is included so the rasterisation
+// queued up by SDL is paid for by the frame that caused it
+template<typename Function>
+double time_frames(SDL_Renderer* render, int frames, Function f) {
+    f();
+    SDL_RenderFlush(render);
+    auto start = clock_type::now();
+    for(int i = 0; i < frames; ++i) {
+        SDL_RenderClear(render);
+        f();
+        SDL_RenderFlush(render);
+    }
+    std::chrono::duration<double, std::milli> elapsed = clock_type::now() - start;
+    return elapsed.count() / frames;
+}
+
+void run(SDL_Renderer* render, const std::vector<sdl::sprite>& sprites, int frames, const char* name) {
+    sdl::render_state state(render);
+    sdl::sprite_batch batch;
+    batch.reserve(sprites.size());
+
+    auto single = time_frames(render, frames, [&] {
+        for(auto&& s : sprites) {
+            s.draw(state);
+        }
+    });
+
+    auto batched = time_frames(render, frames, [&] {
+        batch.clear();
+        for(auto&& s : sprites) {
+            batch.add(s);
+        }
+        batch.draw(state);
+    });
+
+    std::printf("%-10s %10.3f ms %10.3f ms %8.2fx\n", name, single, batched, single / batched);
+}
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    // atoi gives 0 for anything unparseable, at least one frame is needed to divide by
+    auto count = std::max(argc > 1 ? std::atoi(argv[1]) : 10000, 1);
+    auto frames = std::max(argc > 2 ? std::atoi(argv[2]) : 20, 1);
+
+    SDL_Surface* screen = SDL_CreateRGBSurfaceWithFormat(0, 1280, 720, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* render = screen ? SDL_CreateSoftwareRenderer(screen) : nullptr;
+    if(render == nullptr) {
+        std::printf("could not create the software renderer: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    // small sprites so that the per call overhead isn't buried under the fill rate
+    SDL_Surface* image = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_FillRect(image, nullptr, SDL_MapRGBA(image->format, 200, 120, 40, 255));
+    sdl::texture sheet(SDL_CreateTextureFromSurface(render, image));
+    SDL_FreeSurface(image);
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> x(0.0f, 1280.0f);
+    std::uniform_real_distribution<float> y(0.0f, 720.0f);
+    std::uniform_real_distribution<double> angle(0.0, 360.0);
+    std::uniform_int_distribution<int> cell(0, 3);
+
+    std::vector<sdl::sprite> still;
+    std::vector<sdl::sprite> rotated;
+    for(int i = 0; i < count; ++i) {
+        sdl::sprite s(sheet, sdl::rect(cell(rng) * 16, cell(rng) * 16, 16, 16));
+        s.position(sdl::vectorf(x(rng), y(rng)));
+        still.push_back(s);
+        s.origin(8, 8);
+        s.rotation(angle(rng));
+        rotated.push_back(s);
+    }
+
+    std::printf("%d sprites, %d frames\n", count, frames);
+    std::printf("%-10s %13s %13s %9s\n", "", "per sprite", "batched", "speedup");
+    run(render, still, frames, "still");
+    run(render, rotated, frames, "rotated");
+
+    sheet = sdl::texture();
+    SDL_DestroyRenderer(render);
+    SDL_FreeSurface(screen);
+    return 0;
+}
@@ -59,4 +59,42 @@
 #   endif
 #endif
 
+/**
+ * Some parts of the renderer API were added later in the SDL2 lifetime.
+ * These macros allow the newer facilities to be conditionally enabled
+ * depending on the version of SDL2 that is being compiled against.
+ */
+
+#if SDL_VERSION_ATLEAST(2, 0, 10)
+#   if !defined(GUM_HAS_RENDER_FLUSH)
+#       define GUM_HAS_RENDER_FLUSH 1
+#   endif
+#   if !defined(GUM_HAS_RENDER_FLOAT)
+#       define GUM_HAS_RENDER_FLOAT 1
+#   endif
+#endif
+
+#if SDL_VERSION_ATLEAST(2, 0, 16)
+#   if !defined(GUM_HAS_UPDATE_NV_TEXTURE)
+#       define GUM_HAS_UPDATE_NV_TEXTURE 1
+#   endif
+#endif
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+#   if !defined(GUM_HAS_RENDER_GEOMETRY)
+#       define GUM_HAS_RENDER_GEOMETRY 1
+#   endif
+#endif
+
+/**
+ * Exceptions thrown by user callbacks on worker threads are forwarded to the
+ * waiting thread, unless the compiler was told to turn exceptions off.
+ */
+
+#if !defined(GUM_HAS_EXCEPTIONS)
+#   if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#       define GUM_HAS_EXCEPTIONS 1
+#   endif
+#endif
+
 #endif // GUM_CORE_CONFIG_HPP
@@ -0,0 +1,61 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_DETAIL_AABB_HPP
+#define GUM_DETAIL_AABB_HPP
+
+#include <gum/core/config.hpp>
+
+namespace sdl {
+namespace detail {
+// inline replacements for SDL_HasIntersection and SDL_PointInRect for tight loops
+constexpr bool overlaps(const SDL_Rect& a, const SDL_Rect& b) noexcept {
+    return a.w > 0 && a.h > 0 && b.w > 0 && b.h > 0 &&
+           a.x < b.x + b.w && b.x < a.x + a.w &&
+           a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+constexpr bool contains(const SDL_Rect& a, int x, int y) noexcept {
+    return x >= a.x && x < a.x + a.w && y >= a.y && y < a.y + a.h;
+}
+
+constexpr int min(int a, int b) noexcept {
+    return a < b ? a : b;
+}
+
+constexpr int max(int a, int b) noexcept {
+    return a < b ? b : a;
+}
+
+// the region codes used by SDL_IntersectRectAndLine
+enum : int {
+    code_bottom = 1,
+    code_top    = 2,
+    code_left   = 4,
+    code_right  = 8
+};
+
+constexpr int out_code(const SDL_Rect& a, int x, int y) noexcept {
+    return (y < a.y ? code_top : y >= a.y + a.h ? code_bottom : 0) |
+           (x < a.x ? code_left : x >= a.x + a.w ? code_right : 0);
+}
+} // detail
+} // sdl
+
+#endif // GUM_DETAIL_AABB_HPP
@@ -0,0 +1,63 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_DETAIL_BOUNDS_HPP
+#define GUM_DETAIL_BOUNDS_HPP
+
+#include <gum/video/rect.hpp>
+
+namespace sdl {
+namespace detail {
+// grows a bounding box as batches are filled so they can be culled as a whole
+struct bounds_accumulator {
+private:
+    int x1 = 0;
+    int y1 = 0;
+    int x2 = 0;
+    int y2 = 0;
+    bool none = true;
+public:
+    void add(int x, int y, int w, int h) noexcept {
+        if(none) {
+            x1 = x;
+            y1 = y;
+            x2 = x + w;
+            y2 = y + h;
+            none = false;
+            return;
+        }
+
+        x1 = x < x1 ? x : x1;
+        y1 = y < y1 ? y : y1;
+        x2 = x + w > x2 ? x + w : x2;
+        y2 = y + h > y2 ? y + h : y2;
+    }
+
+    void clear() noexcept {
+        none = true;
+    }
+
+    rect result() const noexcept {
+        return none ? rect() : rect(x1, y1, x2 - x1, y2 - y1);
+    }
+};
+} // detail
+} // sdl
+
+#endif // GUM_DETAIL_BOUNDS_HPP
@@ -0,0 +1,98 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_DETAIL_COLOUR_GROUPS_HPP
+#define GUM_DETAIL_COLOUR_GROUPS_HPP
+
+#include <gum/video/colour.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace sdl {
+namespace detail {
+// buckets of elements keyed by colour, the memory of every bucket is
+// kept when cleared so that refilling them every frame doesn't allocate.
+// Buckets are found through a hash of the packed colour so that many
+// distinct colours stay cheap to add
+template<typename T>
+struct colour_groups {
+    struct group {
+        SDL_Color colour;
+        std::vector<T> items;
+    };
+private:
+    std::vector<group> groups;
+    std::unordered_map<uint32_t, std::size_t> index; // packed colour to group
+    std::size_t active = 0;
+    std::size_t last = 0;
+
+    static uint32_t key(const SDL_Color& c) noexcept {
+        return (static_cast<uint32_t>(c.r) << 24) | (static_cast<uint32_t>(c.g) << 16) |
+               (static_cast<uint32_t>(c.b) << 8) | static_cast<uint32_t>(c.a);
+    }
+public:
+    std::vector<T>& operator[](const SDL_Color& c) {
+        // consecutive items usually share a colour
+        if(last < active && groups[last].colour == c) {
+            return groups[last].items;
+        }
+
+        auto result = index.emplace(key(c), active);
+        if(!result.second) {
+            last = result.first->second;
+            return groups[last].items;
+        }
+
+        if(active == groups.size()) {
+            groups.emplace_back();
+        }
+
+        last = active++;
+        groups[last].colour = c;
+        groups[last].items.clear();
+        return groups[last].items;
+    }
+
+    void clear() noexcept {
+        for(std::size_t i = 0; i < active; ++i) {
+            groups[i].items.clear();
+        }
+        index.clear();
+        active = 0;
+        last = 0;
+    }
+
+    std::size_t size() const noexcept {
+        return active;
+    }
+
+    const group* begin() const noexcept {
+        return groups.data();
+    }
+
+    const group* end() const noexcept {
+        return groups.data() + active;
+    }
+};
+} // detail
+} // sdl
+
+#endif // GUM_DETAIL_COLOUR_GROUPS_HPP
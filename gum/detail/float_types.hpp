@@ -0,0 +1,47 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_DETAIL_FLOAT_TYPES_HPP
+#define GUM_DETAIL_FLOAT_TYPES_HPP
+
+#include <gum/core/config.hpp>
+
+namespace sdl {
+namespace detail {
+#if defined(GUM_HAS_RENDER_FLOAT)
+using fpoint = SDL_FPoint;
+using frect = SDL_FRect;
+#else
+// SDL_FPoint and SDL_FRect were added in SDL 2.0.10, these have the same layout
+struct fpoint {
+    float x;
+    float y;
+};
+
+struct frect {
+    float x;
+    float y;
+    float w;
+    float h;
+};
+#endif // GUM_HAS_RENDER_FLOAT
+} // detail
+} // sdl
+
+#endif // GUM_DETAIL_FLOAT_TYPES_HPP
@@ -0,0 +1,185 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_DETAIL_MAPPED_FILE_HPP
+#define GUM_DETAIL_MAPPED_FILE_HPP
+
+#include <gum/core/config.hpp>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+#   if !defined(WIN32_LEAN_AND_MEAN)
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   if !defined(NOMINMAX)
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#else
+#   include <vector>
+#endif
+
+namespace sdl {
+namespace detail {
+// a read only view of a whole file. The file is mapped into memory where the
+// platform allows it, otherwise it is read into a buffer
+struct mapped_file {
+private:
+    const unsigned char* ptr = nullptr;
+    std::size_t size_ = 0;
+#if !defined(_WIN32) && !defined(__unix__) && !defined(__APPLE__)
+    std::vector<unsigned char> buffer;
+#endif
+
+    bool map(const std::string& filename) {
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+        if(file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER length;
+        HANDLE mapping = nullptr;
+        if(GetFileSizeEx(file, &length) && length.QuadPart > 0) {
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        }
+        CloseHandle(file);
+        if(mapping == nullptr) {
+            return false;
+        }
+
+        // the view keeps the mapping alive on its own
+        ptr = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        CloseHandle(mapping);
+        size_ = ptr != nullptr ? static_cast<std::size_t>(length.QuadPart) : 0;
+        return ptr != nullptr;
+#elif defined(__unix__) || defined(__APPLE__)
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if(fd == -1) {
+            return false;
+        }
+
+        struct stat info;
+        void* result = MAP_FAILED;
+        if(::fstat(fd, &info) == 0 && info.st_size > 0) {
+            result = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+        if(result == MAP_FAILED) {
+            return false;
+        }
+
+        ptr = static_cast<const unsigned char*>(result);
+        size_ = static_cast<std::size_t>(info.st_size);
+        return true;
+#else
+        SDL_RWops* file = SDL_RWFromFile(filename.c_str(), "rb");
+        if(file == nullptr) {
+            return false;
+        }
+
+        Sint64 length = SDL_RWsize(file);
+        if(length > 0) {
+            buffer.resize(static_cast<std::size_t>(length));
+            if(SDL_RWread(file, buffer.data(), 1, buffer.size()) != buffer.size()) {
+                buffer.clear();
+            }
+        }
+        SDL_RWclose(file);
+        ptr = buffer.empty() ? nullptr : buffer.data();
+        size_ = buffer.size();
+        return ptr != nullptr;
+#endif
+    }
+public:
+    mapped_file() = default;
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    mapped_file(mapped_file&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    mapped_file& operator=(mapped_file&& other) noexcept {
+        if(this != &other) {
+            close();
+            ptr = other.ptr;
+            size_ = other.size_;
+#if !defined(_WIN32) && !defined(__unix__) && !defined(__APPLE__)
+            buffer = std::move(other.buffer);
+#endif
+            other.ptr = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    ~mapped_file() {
+        close();
+    }
+
+    // empty files can't be mapped and fail to open
+    bool open(const std::string& filename) {
+        close();
+        if(!map(filename)) {
+            SDL_SetError("could not open '%s'", filename.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    void close() noexcept {
+        if(ptr == nullptr) {
+            return;
+        }
+#if defined(_WIN32)
+        UnmapViewOfFile(ptr);
+#elif defined(__unix__) || defined(__APPLE__)
+        ::munmap(const_cast<unsigned char*>(ptr), size_);
+#else
+        buffer.clear();
+#endif
+        ptr = nullptr;
+        size_ = 0;
+    }
+
+    const unsigned char* data() const noexcept {
+        return ptr;
+    }
+
+    std::size_t size() const noexcept {
+        return size_;
+    }
+
+    explicit operator bool() const noexcept {
+        return ptr != nullptr;
+    }
+};
+} // detail
+} // sdl
+
+#endif // GUM_DETAIL_MAPPED_FILE_HPP
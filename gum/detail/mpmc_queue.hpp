@@ -0,0 +1,120 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_DETAIL_MPMC_QUEUE_HPP
+#define GUM_DETAIL_MPMC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace sdl {
+namespace detail {
+// a bounded lock free queue for any number of producers and consumers, after
+// Dmitry Vyukov's design. Every cell has a sequence number telling whether it's
+// ready to be written or read for the current lap around the buffer
+template<typename T>
+struct mpmc_queue {
+private:
+    struct cell {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    // padded onto separate cache lines so producers and consumers don't slow each other down
+    std::unique_ptr<cell[]> cells;
+    std::size_t mask;
+    char padding0[64];
+    std::atomic<std::size_t> tail;
+    char padding1[64];
+    std::atomic<std::size_t> head;
+    char padding2[64];
+public:
+    // the capacity is rounded up to a power of two
+    explicit mpmc_queue(std::size_t capacity): tail(0), head(0) {
+        std::size_t size = 2;
+        while(size < capacity) {
+            size *= 2;
+        }
+
+        cells.reset(new cell[size]);
+        mask = size - 1;
+        for(std::size_t i = 0; i < size; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    // returns false when the queue is full
+    bool try_push(T& value) {
+        auto position = tail.load(std::memory_order_relaxed);
+        for(;;) {
+            auto&& c = cells[position & mask];
+            auto sequence = c.sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if(difference == 0) {
+                if(tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    c.value = std::move(value);
+                    c.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if(difference < 0) {
+                return false;
+            }
+            else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // returns false when the queue is empty
+    bool try_pop(T& value) {
+        auto position = head.load(std::memory_order_relaxed);
+        for(;;) {
+            auto&& c = cells[position & mask];
+            auto sequence = c.sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+            if(difference == 0) {
+                if(head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = std::move(c.value);
+                    c.sequence.store(position + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if(difference < 0) {
+                return false;
+            }
+            else {
+                position = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::size_t capacity() const noexcept {
+        return mask + 1;
+    }
+};
+} // detail
+} // sdl
+
+#endif // GUM_DETAIL_MPMC_QUEUE_HPP
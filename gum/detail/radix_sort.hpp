@@ -0,0 +1,134 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_DETAIL_RADIX_SORT_HPP
+#define GUM_DETAIL_RADIX_SORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sdl {
+namespace detail {
+struct sort_entry {
+    uint64_t key;
+    uint32_t index;
+};
+
+// stable least significant digit radix sort over the 64-bit keys
+// scratch is resized as needed so it can be reused between calls
+inline void radix_sort(std::vector<sort_entry>& entries, std::vector<sort_entry>& scratch) {
+    auto size = entries.size();
+    if(size < 2) {
+        return;
+    }
+
+    // already sorted input is common when the keys barely change between frames
+    std::size_t i = 1;
+    while(i < size && entries[i - 1].key <= entries[i].key) {
+        ++i;
+    }
+
+    if(i == size) {
+        return;
+    }
+
+    // every histogram is built in a single pass
+    std::size_t counts[8][256] = {};
+    for(auto&& entry : entries) {
+        for(int byte = 0; byte < 8; ++byte) {
+            ++counts[byte][(entry.key >> (byte * 8)) & 0xff];
+        }
+    }
+
+    scratch.resize(size);
+    auto* source = entries.data();
+    auto* destination = scratch.data();
+    for(int byte = 0; byte < 8; ++byte) {
+        auto&& count = counts[byte];
+        auto shift = byte * 8;
+
+        // every key has the same digit so this pass wouldn't move anything
+        if(count[(source[0].key >> shift) & 0xff] == size) {
+            continue;
+        }
+
+        std::size_t offsets[256];
+        std::size_t total = 0;
+        for(int digit = 0; digit < 256; ++digit) {
+            offsets[digit] = total;
+            total += count[digit];
+        }
+
+        for(std::size_t j = 0; j < size; ++j) {
+            destination[offsets[(source[j].key >> shift) & 0xff]++] = source[j];
+        }
+
+        auto* temp = source;
+        source = destination;
+        destination = temp;
+    }
+
+    if(source != entries.data()) {
+        entries.swap(scratch);
+    }
+}
+
+inline bool sorted_before(const sort_entry& lhs, const sort_entry& rhs) noexcept {
+    return lhs.key != rhs.key ? lhs.key < rhs.key : lhs.index < rhs.index;
+}
+
+// sorts by key with ties kept in index order, just like radix_sort over entries in
+// index order would. The entries are expected to be in the order of a previous sort
+// with updated keys, which is close to sorted when little changed between frames.
+// An insertion sort handles that in about linear time and gives up for the radix
+// sort once it's done more work than the radix sort would
+inline void coherent_sort(std::vector<sort_entry>& entries, std::vector<sort_entry>& scratch) {
+    auto size = entries.size();
+    std::size_t budget = size * 4;
+    std::size_t moves = 0;
+    for(std::size_t i = 1; i < size; ++i) {
+        if(!sorted_before(entries[i], entries[i - 1])) {
+            continue;
+        }
+
+        auto entry = entries[i];
+        auto j = i;
+        for(; j > 0 && sorted_before(entry, entries[j - 1]); --j) {
+            entries[j] = entries[j - 1];
+        }
+        entries[j] = entry;
+
+        moves += i - j;
+        if(moves > budget) {
+            // the radix sort is stable so it needs the entries back in index order
+            scratch.resize(size);
+            for(auto&& e : entries) {
+                scratch[e.index] = e;
+            }
+            entries.swap(scratch);
+            radix_sort(entries, scratch);
+            return;
+        }
+    }
+}
+} // detail
+} // sdl
+
+#endif // GUM_DETAIL_RADIX_SORT_HPP
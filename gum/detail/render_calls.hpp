@@ -0,0 +1,88 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_DETAIL_RENDER_CALLS_HPP
+#define GUM_DETAIL_RENDER_CALLS_HPP
+
+#include <gum/core/config.hpp>
+#include <cstddef>
+
+namespace sdl {
+namespace detail {
+// overloads over the integer and floating point renderer calls so drawables can
+// pass along whatever render_state::translate returns for their coordinates
+inline void draw_points(SDL_Renderer* render, const SDL_Point* points, std::size_t count) noexcept {
+    SDL_RenderDrawPoints(render, points, static_cast<int>(count));
+}
+
+inline void draw_lines(SDL_Renderer* render, const SDL_Point* points, std::size_t count) noexcept {
+    SDL_RenderDrawLines(render, points, static_cast<int>(count));
+}
+
+inline void draw_rects(SDL_Renderer* render, const SDL_Rect* rects, std::size_t count) noexcept {
+    SDL_RenderDrawRects(render, rects, static_cast<int>(count));
+}
+
+inline void fill_rects(SDL_Renderer* render, const SDL_Rect* rects, std::size_t count) noexcept {
+    SDL_RenderFillRects(render, rects, static_cast<int>(count));
+}
+
+// the plain copy is used when there's no rotation or flip
+inline void copy(SDL_Renderer* render, SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& destination,
+                 double angle, const SDL_Point& center, SDL_RendererFlip flip) noexcept {
+    if(angle == 0.0 && flip == SDL_FLIP_NONE) {
+        SDL_RenderCopy(render, texture, &source, &destination);
+    }
+    else {
+        SDL_RenderCopyEx(render, texture, &source, &destination, angle, &center, flip);
+    }
+}
+
+#if defined(GUM_HAS_RENDER_FLOAT)
+inline void draw_points(SDL_Renderer* render, const SDL_FPoint* points, std::size_t count) noexcept {
+    SDL_RenderDrawPointsF(render, points, static_cast<int>(count));
+}
+
+inline void draw_lines(SDL_Renderer* render, const SDL_FPoint* points, std::size_t count) noexcept {
+    SDL_RenderDrawLinesF(render, points, static_cast<int>(count));
+}
+
+inline void draw_rects(SDL_Renderer* render, const SDL_FRect* rects, std::size_t count) noexcept {
+    SDL_RenderDrawRectsF(render, rects, static_cast<int>(count));
+}
+
+inline void fill_rects(SDL_Renderer* render, const SDL_FRect* rects, std::size_t count) noexcept {
+    SDL_RenderFillRectsF(render, rects, static_cast<int>(count));
+}
+
+inline void copy(SDL_Renderer* render, SDL_Texture* texture, const SDL_Rect& source, const SDL_FRect& destination,
+                 double angle, const SDL_Point& center, SDL_RendererFlip flip) noexcept {
+    if(angle == 0.0 && flip == SDL_FLIP_NONE) {
+        SDL_RenderCopyF(render, texture, &source, &destination);
+    }
+    else {
+        SDL_FPoint pivot = { static_cast<float>(center.x), static_cast<float>(center.y) };
+        SDL_RenderCopyExF(render, texture, &source, &destination, angle, &pivot, flip);
+    }
+}
+#endif // GUM_HAS_RENDER_FLOAT
+} // detail
+} // sdl
+
+#endif // GUM_DETAIL_RENDER_CALLS_HPP
@@ -0,0 +1,141 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_DETAIL_SIMD_HPP
+#define GUM_DETAIL_SIMD_HPP
+
+#include <gum/platform/cpu.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// SIMD kernels are compiled for their instruction set through target attributes
+// and picked at runtime, so no special compiler flags are needed. Define
+// GUM_NO_SIMD to only use the scalar versions.
+#if !defined(GUM_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#   define GUM_HAS_X86_SIMD 1
+#   include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#   define GUM_TARGET(x) __attribute__((target(x)))
+#else
+#   define GUM_TARGET(x)
+#endif
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+namespace sdl {
+namespace detail {
+enum class simd_level {
+    scalar,
+    sse41,
+    avx2
+};
+
+// the best instruction set available, checked once
+inline simd_level simd() noexcept {
+#if defined(GUM_HAS_X86_SIMD)
+    static const simd_level level = has_avx2() ? simd_level::avx2 :
+                                    has_sse41() ? simd_level::sse41 : simd_level::scalar;
+    return level;
+#else
+    return simd_level::scalar;
+#endif
+}
+
+inline int count_trailing_zeros(uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<int>(index);
+#else
+    int result = 0;
+    while((value & 1) == 0) {
+        value >>= 1;
+        ++result;
+    }
+    return result;
+#endif
+}
+
+// calls f(index) for every set bit of a mask made of 64-bit words
+template<typename Function>
+inline void for_each_bit(const uint64_t* words, std::size_t count, Function f) {
+    for(std::size_t i = 0; i < count; ++i) {
+        auto word = words[i];
+        while(word != 0) {
+            f(i * 64 + static_cast<std::size_t>(count_trailing_zeros(word)));
+            word &= word - 1;
+        }
+    }
+}
+
+// allocates memory aligned for aligned vector loads
+template<typename T, std::size_t Alignment = 32>
+struct aligned_allocator {
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = aligned_allocator<U, Alignment>;
+    };
+
+    aligned_allocator() noexcept = default;
+
+    template<typename U>
+    aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t count) {
+        // the original pointer is stored right before the aligned block
+        auto* raw = std::malloc(count * sizeof(T) + Alignment + sizeof(void*));
+        if(raw == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        auto address = reinterpret_cast<uintptr_t>(raw) + sizeof(void*);
+        address = (address + Alignment - 1) & ~static_cast<uintptr_t>(Alignment - 1);
+        reinterpret_cast<void**>(address)[-1] = raw;
+        return reinterpret_cast<T*>(address);
+    }
+
+    void deallocate(T* ptr, std::size_t) noexcept {
+        if(ptr != nullptr) {
+            std::free(reinterpret_cast<void**>(ptr)[-1]);
+        }
+    }
+
+    // friends so that they don't hide other operators in sdl::detail
+    friend bool operator==(const aligned_allocator&, const aligned_allocator&) noexcept {
+        return true;
+    }
+
+    friend bool operator!=(const aligned_allocator&, const aligned_allocator&) noexcept {
+        return false;
+    }
+};
+} // detail
+} // sdl
+
+#endif // GUM_DETAIL_SIMD_HPP
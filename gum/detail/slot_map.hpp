@@ -0,0 +1,175 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_DETAIL_SLOT_MAP_HPP
+#define GUM_DETAIL_SLOT_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace sdl {
+namespace detail {
+// the bookkeeping behind handles to values kept contiguous in dense arrays. A slot
+// stays the same while its value moves around, and its generation is bumped when
+// the value is erased so that old handles stop matching it. Erasing moves the
+// last value into the hole, which the owner of the dense arrays has to mirror
+struct slot_table {
+private:
+    std::vector<uint32_t> owners;      // dense index -> slot
+    std::vector<uint32_t> dense;       // slot -> dense index
+    std::vector<uint32_t> generations; // slot -> generation
+    std::vector<uint32_t> free_slots;  // always has room for every slot so freeing never allocates
+public:
+    // a slot for a value appended to the end of the dense arrays
+    uint32_t insert() {
+        uint32_t slot;
+        if(!free_slots.empty()) {
+            slot = free_slots.back();
+            free_slots.pop_back();
+        }
+        else {
+            slot = static_cast<uint32_t>(dense.size());
+            dense.push_back(0);
+            generations.push_back(0);
+            if(free_slots.capacity() < dense.size()) {
+                free_slots.reserve(dense.capacity());
+            }
+        }
+
+        dense[slot] = static_cast<uint32_t>(owners.size());
+        owners.push_back(slot);
+        return slot;
+    }
+
+    // frees the slot and returns the dense index of its value. The last value in
+    // the dense arrays has to be moved there, if it isn't the same one, then removed
+    uint32_t erase(uint32_t slot) noexcept {
+        auto i = dense[slot];
+        auto last = static_cast<uint32_t>(owners.size() - 1);
+        if(i != last) {
+            owners[i] = owners[last];
+            dense[owners[i]] = i;
+        }
+
+        owners.pop_back();
+        ++generations[slot];
+        free_slots.push_back(slot);
+        return i;
+    }
+
+    void clear() noexcept {
+        for(auto&& slot : owners) {
+            ++generations[slot];
+            free_slots.push_back(slot);
+        }
+        owners.clear();
+    }
+
+    uint32_t generation(uint32_t slot) const noexcept {
+        return generations[slot];
+    }
+
+    bool contains(uint32_t slot, uint32_t generation) const noexcept {
+        return slot < generations.size() && generations[slot] == generation;
+    }
+
+    // slot -> dense index
+    uint32_t index(uint32_t slot) const noexcept {
+        return dense[slot];
+    }
+
+    // dense index -> slot
+    uint32_t slot(std::size_t index) const noexcept {
+        return owners[index];
+    }
+
+    std::size_t size() const noexcept {
+        return owners.size();
+    }
+
+    bool empty() const noexcept {
+        return owners.empty();
+    }
+
+    void reserve(std::size_t count) {
+        owners.reserve(count);
+    }
+};
+
+// values kept contiguous in a dense array and referred to through a slot, see slot_table
+template<typename T>
+struct slot_map {
+private:
+    std::vector<T> values;
+    slot_table slots;
+public:
+    template<typename... Args>
+    uint32_t emplace(Args&&... args) {
+        values.emplace_back(std::forward<Args>(args)...);
+        return slots.insert();
+    }
+
+    uint32_t generation(uint32_t slot) const noexcept {
+        return slots.generation(slot);
+    }
+
+    bool contains(uint32_t slot, uint32_t generation) const noexcept {
+        return slots.contains(slot, generation);
+    }
+
+    void erase(uint32_t slot) {
+        auto i = slots.erase(slot);
+        if(i != values.size() - 1) {
+            values[i] = std::move(values.back());
+        }
+        values.pop_back();
+    }
+
+    void clear() noexcept {
+        slots.clear();
+        values.clear();
+    }
+
+    T& operator[](uint32_t slot) noexcept {
+        return values[slots.index(slot)];
+    }
+
+    const T& operator[](uint32_t slot) const noexcept {
+        return values[slots.index(slot)];
+    }
+
+    std::vector<T>& items() noexcept {
+        return values;
+    }
+
+    const std::vector<T>& items() const noexcept {
+        return values;
+    }
+
+    void reserve(std::size_t count) {
+        values.reserve(count);
+        slots.reserve(count);
+    }
+};
+} // detail
+} // sdl
+
+#endif // GUM_DETAIL_SLOT_MAP_HPP
@@ -0,0 +1,216 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_DETAIL_TESSELLATE_HPP
+#define GUM_DETAIL_TESSELLATE_HPP
+
+#include <gum/core/config.hpp>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace sdl {
+namespace detail {
+inline float cross(const SDL_FPoint& a, const SDL_FPoint& b, const SDL_FPoint& c) noexcept {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+// twice the signed area, the sign gives the winding of the polygon
+inline float signed_area(const SDL_FPoint* points, std::size_t count) noexcept {
+    float result = 0.0f;
+    for(std::size_t i = 0, j = count - 1; i < count; j = i++) {
+        result += points[j].x * points[i].y - points[i].x * points[j].y;
+    }
+    return result;
+}
+
+inline int sign_of(float value) noexcept {
+    return value > 0.0f ? 1 : value < 0.0f ? -1 : 0;
+}
+
+// collinear and repeated points don't count against being convex. Turning the same
+// way at every corner isn't enough on its own, a pentagram does that while going
+// around twice. Going around once means the edges change between moving left and
+// right, and between moving up and down, at most twice each
+inline bool is_convex(const SDL_FPoint* points, std::size_t count) noexcept {
+    if(count < 4) {
+        return true;
+    }
+
+    int sign = 0;
+    int first_x = 0, last_x = 0, flips_x = 0;
+    int first_y = 0, last_y = 0, flips_y = 0;
+    for(std::size_t i = 0; i < count; ++i) {
+        auto&& a = points[i];
+        auto&& b = points[(i + 1) % count];
+        int current = sign_of(cross(a, b, points[(i + 2) % count]));
+        if(current != 0) {
+            if(sign != 0 && current != sign) {
+                return false;
+            }
+            sign = current;
+        }
+
+        int x = sign_of(b.x - a.x);
+        if(x != 0) {
+            flips_x += last_x != 0 && x != last_x;
+            first_x = first_x == 0 ? x : first_x;
+            last_x = x;
+        }
+
+        int y = sign_of(b.y - a.y);
+        if(y != 0) {
+            flips_y += last_y != 0 && y != last_y;
+            first_y = first_y == 0 ? y : first_y;
+            last_y = y;
+        }
+    }
+
+    // the edge from the last point closes the loop back to the first
+    flips_x += last_x != first_x;
+    flips_y += last_y != first_y;
+    return flips_x <= 2 && flips_y <= 2;
+}
+
+// whether two edges that aren't next to each other cross, touching doesn't count.
+// Ear clipping can still succeed on some of these, e.g. a pentagram, so it's
+// checked separately. This is O(n^2) like the ear clipping itself
+inline bool self_intersects(const SDL_FPoint* points, std::size_t count) noexcept {
+    for(std::size_t i = 0; i + 2 < count; ++i) {
+        auto&& a = points[i];
+        auto&& b = points[i + 1];
+        for(std::size_t j = i + 2; j < count; ++j) {
+            if(i == 0 && j + 1 == count) {
+                continue;
+            }
+
+            auto&& c = points[j];
+            auto&& d = points[(j + 1) % count];
+            if(sign_of(cross(a, b, c)) * sign_of(cross(a, b, d)) < 0 &&
+               sign_of(cross(c, d, a)) * sign_of(cross(c, d, b)) < 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// the triangles of a convex polygon all share its first point
+inline void triangulate_fan(std::size_t count, int base, std::vector<int>& indices) {
+    for(std::size_t i = 1; i + 1 < count; ++i) {
+        int triangle[] = { base, base + static_cast<int>(i), base + static_cast<int>(i) + 1 };
+        indices.insert(indices.end(), triangle, triangle + 3);
+    }
+}
+
+inline bool inside_triangle(const SDL_FPoint& p, const SDL_FPoint& a, const SDL_FPoint& b, const SDL_FPoint& c) noexcept {
+    // points on the edges count as inside so that touching ears are rejected
+    return cross(a, b, p) >= 0.0f && cross(b, c, p) >= 0.0f && cross(c, a, p) >= 0.0f;
+}
+
+// ear clipping for simple polygons of either winding, which is O(n^2) at worst.
+// Polygons that aren't simple (e.g. self intersecting) have no ears left at some
+// point, the rest is then filled as a fan and false is returned
+inline bool triangulate_ears(const SDL_FPoint* points, std::size_t count, int base,
+                             std::vector<int>& indices, std::vector<int>& remaining) {
+    remaining.clear();
+    if(count < 3) {
+        return true;
+    }
+
+    // the remaining vertices are kept counter clockwise (in the maths sense) so ears turn left
+    if(signed_area(points, count) >= 0.0f) {
+        for(std::size_t i = 0; i < count; ++i) {
+            remaining.push_back(static_cast<int>(i));
+        }
+    }
+    else {
+        for(std::size_t i = count; i > 0; --i) {
+            remaining.push_back(static_cast<int>(i - 1));
+        }
+    }
+
+    std::size_t i = 0;
+    std::size_t misses = 0;
+    while(remaining.size() > 3) {
+        auto size = remaining.size();
+        if(misses == size) {
+            // nothing left is an ear
+            for(std::size_t j = 1; j + 1 < size; ++j) {
+                int triangle[] = { base + remaining[0], base + remaining[j], base + remaining[j + 1] };
+                indices.insert(indices.end(), triangle, triangle + 3);
+            }
+            return false;
+        }
+
+        auto prev = remaining[(i + size - 1) % size];
+        auto current = remaining[i % size];
+        auto next = remaining[(i + 1) % size];
+        auto&& a = points[prev];
+        auto&& b = points[current];
+        auto&& c = points[next];
+        bool ear = cross(a, b, c) > 0.0f;
+        for(std::size_t j = 0; ear && j < size; ++j) {
+            auto other = remaining[j];
+            if(other != prev && other != current && other != next && inside_triangle(points[other], a, b, c)) {
+                ear = false;
+            }
+        }
+
+        if(!ear) {
+            i = (i + 1) % size;
+            ++misses;
+            continue;
+        }
+
+        int triangle[] = { base + prev, base + current, base + next };
+        indices.insert(indices.end(), triangle, triangle + 3);
+        remaining.erase(remaining.begin() + static_cast<std::ptrdiff_t>(i % size));
+        i = i % size == 0 ? 0 : (i % size) - 1;
+        misses = 0;
+    }
+
+    int triangle[] = { base + remaining[0], base + remaining[1], base + remaining[2] };
+    indices.insert(indices.end(), triangle, triangle + 3);
+    return true;
+}
+
+// the amount of segments needed for a circle to stay within a quarter of a pixel of the real one
+inline std::size_t circle_segments(float radius) noexcept {
+    const float tolerance = 0.25f;
+    if(radius <= tolerance) {
+        return 8;
+    }
+
+    auto segments = static_cast<std::size_t>(std::ceil(3.14159265f / std::acos(1.0f - tolerance / radius)));
+    return segments < 8 ? 8 : segments > 1024 ? 1024 : segments;
+}
+
+// adds points along an arc, both ends included
+inline void add_arc(std::vector<SDL_FPoint>& points, float cx, float cy, float radius,
+                    float start, float sweep, std::size_t segments) {
+    for(std::size_t i = 0; i <= segments; ++i) {
+        auto angle = start + sweep * static_cast<float>(i) / static_cast<float>(segments);
+        points.push_back({ cx + radius * std::cos(angle), cy + radius * std::sin(angle) });
+    }
+}
+} // detail
+} // sdl
+
+#endif // GUM_DETAIL_TESSELLATE_HPP
@@ -20,6 +20,7 @@
 #ifndef GUM_DETAIL_TYPE_TRAITS_HPP
 #define GUM_DETAIL_TYPE_TRAITS_HPP
 
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 
@@ -27,6 +28,9 @@
 struct SDL_Renderer;
 
 namespace sdl {
+struct render_state;
+struct command_buffer;
+
 namespace detail {
 struct is_renderer_drawable_impl {
     template<typename T, typename U = decltype(std::declval<T>().draw(std::declval<SDL_Renderer*>()))>
@@ -34,10 +38,65 @@ struct is_renderer_drawable_impl {
     template<typename...>
     static std::false_type test(...);
 };
+
+struct is_state_drawable_impl {
+    template<typename T, typename U = decltype(std::declval<T>().draw(std::declval<render_state&>()))>
+    static std::true_type test(int);
+    template<typename...>
+    static std::false_type test(...);
+};
+
+struct is_command_recordable_impl {
+    template<typename T, typename U = decltype(std::declval<T>().record(std::declval<command_buffer&>(), 0, 0))>
+    static std::true_type test(int);
+    template<typename...>
+    static std::false_type test(...);
+};
+
+struct has_bounds_impl {
+    template<typename T, typename U = decltype(std::declval<T>().bounds())>
+    static std::true_type test(int);
+    template<typename...>
+    static std::false_type test(...);
+};
+
+// C++11 replacements for std::index_sequence and std::make_index_sequence
+template<std::size_t... Is>
+struct index_sequence {};
+
+template<std::size_t N, std::size_t... Is>
+struct make_index_sequence_impl : make_index_sequence_impl<N - 1, N - 1, Is...> {};
+
+template<std::size_t... Is>
+struct make_index_sequence_impl<0, Is...> {
+    using type = index_sequence<Is...>;
+};
+
+template<std::size_t N>
+using make_index_sequence = typename make_index_sequence_impl<N>::type;
+
+// the position of T in Ts..., which must contain it exactly once
+template<typename T, typename... Ts>
+struct type_index;
+
+template<typename T, typename... Ts>
+struct type_index<T, T, Ts...> : std::integral_constant<std::size_t, 0> {};
+
+template<typename T, typename U, typename... Ts>
+struct type_index<T, U, Ts...> : std::integral_constant<std::size_t, 1 + type_index<T, Ts...>::value> {};
 } // detail
 
 template<typename Drawable>
 struct is_renderer_drawable : decltype(detail::is_renderer_drawable_impl::test<Drawable>(0)) {};
+
+template<typename Drawable>
+struct is_state_drawable : decltype(detail::is_state_drawable_impl::test<Drawable>(0)) {};
+
+template<typename Drawable>
+struct is_command_recordable : decltype(detail::is_command_recordable_impl::test<Drawable>(0)) {};
+
+template<typename Drawable>
+struct has_bounds : decltype(detail::has_bounds_impl::test<Drawable>(0)) {};
 } // sdl
 
 #endif // GUM_DETAIL_TYPE_TRAITS_HPP
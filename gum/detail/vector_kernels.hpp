@@ -0,0 +1,316 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_DETAIL_VECTOR_KERNELS_HPP
+#define GUM_DETAIL_VECTOR_KERNELS_HPP
+
+#include <gum/detail/simd.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace sdl {
+namespace detail {
+// bulk operations over separate x and y arrays working on [first, last). first and last
+// are multiples of 8 and the arrays are 32-byte aligned, except for the output arrays
+// of dot and distance_squared
+struct vector_kernel_table {
+    void (*add)(float* x, float* y, const float* ox, const float* oy, std::size_t first, std::size_t last);
+    void (*translate)(float* x, float* y, float dx, float dy, std::size_t first, std::size_t last);
+    void (*scale)(float* x, float* y, float sx, float sy, std::size_t first, std::size_t last);
+    void (*multiply_add)(float* x, float* y, const float* vx, const float* vy, float dt, std::size_t first, std::size_t last);
+    void (*dot)(const float* x, const float* y, const float* ox, const float* oy, float* out, std::size_t first, std::size_t last);
+    void (*distance_squared)(const float* x, const float* y, float px, float py, float* out, std::size_t first, std::size_t last);
+    void (*clamp)(float* x, float* y, float x1, float y1, float x2, float y2, std::size_t first, std::size_t last);
+    void (*within)(const float* x, const float* y, float px, float py, float limit, uint64_t* mask, std::size_t first, std::size_t last);
+};
+
+struct scalar_vector_kernels {
+    static void add(float* x, float* y, const float* ox, const float* oy, std::size_t first, std::size_t last) {
+        for(auto i = first; i < last; ++i) {
+            x[i] += ox[i];
+            y[i] += oy[i];
+        }
+    }
+
+    static void translate(float* x, float* y, float dx, float dy, std::size_t first, std::size_t last) {
+        for(auto i = first; i < last; ++i) {
+            x[i] += dx;
+            y[i] += dy;
+        }
+    }
+
+    static void scale(float* x, float* y, float sx, float sy, std::size_t first, std::size_t last) {
+        for(auto i = first; i < last; ++i) {
+            x[i] *= sx;
+            y[i] *= sy;
+        }
+    }
+
+    static void multiply_add(float* x, float* y, const float* vx, const float* vy, float dt, std::size_t first, std::size_t last) {
+        for(auto i = first; i < last; ++i) {
+            x[i] += vx[i] * dt;
+            y[i] += vy[i] * dt;
+        }
+    }
+
+    static void dot(const float* x, const float* y, const float* ox, const float* oy, float* out, std::size_t first, std::size_t last) {
+        for(auto i = first; i < last; ++i) {
+            out[i] = x[i] * ox[i] + y[i] * oy[i];
+        }
+    }
+
+    static void distance_squared(const float* x, const float* y, float px, float py, float* out, std::size_t first, std::size_t last) {
+        for(auto i = first; i < last; ++i) {
+            auto dx = x[i] - px;
+            auto dy = y[i] - py;
+            out[i] = dx * dx + dy * dy;
+        }
+    }
+
+    static void clamp(float* x, float* y, float x1, float y1, float x2, float y2, std::size_t first, std::size_t last) {
+        for(auto i = first; i < last; ++i) {
+            x[i] = x[i] < x1 ? x1 : x[i] > x2 ? x2 : x[i];
+            y[i] = y[i] < y1 ? y1 : y[i] > y2 ? y2 : y[i];
+        }
+    }
+
+    // sets the bit of every vector closer than sqrt(limit) to the point
+    static void within(const float* x, const float* y, float px, float py, float limit, uint64_t* mask, std::size_t first, std::size_t last) {
+        for(auto i = first; i < last; ++i) {
+            auto dx = x[i] - px;
+            auto dy = y[i] - py;
+            if(dx * dx + dy * dy < limit) {
+                mask[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+    }
+};
+
+#if defined(GUM_HAS_X86_SIMD)
+struct sse_vector_kernels {
+    GUM_TARGET("sse4.1")
+    static void add(float* x, float* y, const float* ox, const float* oy, std::size_t first, std::size_t last) {
+        for(auto i = first; i < last; i += 4) {
+            _mm_store_ps(x + i, _mm_add_ps(_mm_load_ps(x + i), _mm_load_ps(ox + i)));
+            _mm_store_ps(y + i, _mm_add_ps(_mm_load_ps(y + i), _mm_load_ps(oy + i)));
+        }
+    }
+
+    GUM_TARGET("sse4.1")
+    static void translate(float* x, float* y, float dx, float dy, std::size_t first, std::size_t last) {
+        auto vx = _mm_set1_ps(dx);
+        auto vy = _mm_set1_ps(dy);
+        for(auto i = first; i < last; i += 4) {
+            _mm_store_ps(x + i, _mm_add_ps(_mm_load_ps(x + i), vx));
+            _mm_store_ps(y + i, _mm_add_ps(_mm_load_ps(y + i), vy));
+        }
+    }
+
+    GUM_TARGET("sse4.1")
+    static void scale(float* x, float* y, float sx, float sy, std::size_t first, std::size_t last) {
+        auto vx = _mm_set1_ps(sx);
+        auto vy = _mm_set1_ps(sy);
+        for(auto i = first; i < last; i += 4) {
+            _mm_store_ps(x + i, _mm_mul_ps(_mm_load_ps(x + i), vx));
+            _mm_store_ps(y + i, _mm_mul_ps(_mm_load_ps(y + i), vy));
+        }
+    }
+
+    GUM_TARGET("sse4.1")
+    static void multiply_add(float* x, float* y, const float* vx, const float* vy, float dt, std::size_t first, std::size_t last) {
+        auto step = _mm_set1_ps(dt);
+        for(auto i = first; i < last; i += 4) {
+            _mm_store_ps(x + i, _mm_add_ps(_mm_load_ps(x + i), _mm_mul_ps(_mm_load_ps(vx + i), step)));
+            _mm_store_ps(y + i, _mm_add_ps(_mm_load_ps(y + i), _mm_mul_ps(_mm_load_ps(vy + i), step)));
+        }
+    }
+
+    GUM_TARGET("sse4.1")
+    static void dot(const float* x, const float* y, const float* ox, const float* oy, float* out, std::size_t first, std::size_t last) {
+        for(auto i = first; i < last; i += 4) {
+            auto a = _mm_mul_ps(_mm_load_ps(x + i), _mm_load_ps(ox + i));
+            auto b = _mm_mul_ps(_mm_load_ps(y + i), _mm_load_ps(oy + i));
+            _mm_storeu_ps(out + i, _mm_add_ps(a, b));
+        }
+    }
+
+    GUM_TARGET("sse4.1")
+    static __m128 squared(const float* x, const float* y, __m128 px, __m128 py, std::size_t i) {
+        auto dx = _mm_sub_ps(_mm_load_ps(x + i), px);
+        auto dy = _mm_sub_ps(_mm_load_ps(y + i), py);
+        return _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+    }
+
+    GUM_TARGET("sse4.1")
+    static void distance_squared(const float* x, const float* y, float px, float py, float* out, std::size_t first, std::size_t last) {
+        auto vx = _mm_set1_ps(px);
+        auto vy = _mm_set1_ps(py);
+        for(auto i = first; i < last; i += 4) {
+            _mm_storeu_ps(out + i, squared(x, y, vx, vy, i));
+        }
+    }
+
+    GUM_TARGET("sse4.1")
+    static void clamp(float* x, float* y, float x1, float y1, float x2, float y2, std::size_t first, std::size_t last) {
+        auto left = _mm_set1_ps(x1);
+        auto top = _mm_set1_ps(y1);
+        auto right = _mm_set1_ps(x2);
+        auto bottom = _mm_set1_ps(y2);
+        for(auto i = first; i < last; i += 4) {
+            _mm_store_ps(x + i, _mm_min_ps(_mm_max_ps(_mm_load_ps(x + i), left), right));
+            _mm_store_ps(y + i, _mm_min_ps(_mm_max_ps(_mm_load_ps(y + i), top), bottom));
+        }
+    }
+
+    GUM_TARGET("sse4.1")
+    static void within(const float* x, const float* y, float px, float py, float limit, uint64_t* mask, std::size_t first, std::size_t last) {
+        auto vx = _mm_set1_ps(px);
+        auto vy = _mm_set1_ps(py);
+        auto bound = _mm_set1_ps(limit);
+        for(auto i = first; i < last; i += 4) {
+            auto inside = _mm_cmplt_ps(squared(x, y, vx, vy, i), bound);
+            mask[i / 64] |= static_cast<uint64_t>(_mm_movemask_ps(inside)) << (i % 64);
+        }
+    }
+};
+#endif // GUM_HAS_X86_SIMD
+
+#if defined(GUM_HAS_X86_SIMD)
+struct avx_vector_kernels {
+    GUM_TARGET("avx2")
+    static void add(float* x, float* y, const float* ox, const float* oy, std::size_t first, std::size_t last) {
+        for(auto i = first; i < last; i += 8) {
+            _mm256_store_ps(x + i, _mm256_add_ps(_mm256_load_ps(x + i), _mm256_load_ps(ox + i)));
+            _mm256_store_ps(y + i, _mm256_add_ps(_mm256_load_ps(y + i), _mm256_load_ps(oy + i)));
+        }
+    }
+
+    GUM_TARGET("avx2")
+    static void translate(float* x, float* y, float dx, float dy, std::size_t first, std::size_t last) {
+        auto vx = _mm256_set1_ps(dx);
+        auto vy = _mm256_set1_ps(dy);
+        for(auto i = first; i < last; i += 8) {
+            _mm256_store_ps(x + i, _mm256_add_ps(_mm256_load_ps(x + i), vx));
+            _mm256_store_ps(y + i, _mm256_add_ps(_mm256_load_ps(y + i), vy));
+        }
+    }
+
+    GUM_TARGET("avx2")
+    static void scale(float* x, float* y, float sx, float sy, std::size_t first, std::size_t last) {
+        auto vx = _mm256_set1_ps(sx);
+        auto vy = _mm256_set1_ps(sy);
+        for(auto i = first; i < last; i += 8) {
+            _mm256_store_ps(x + i, _mm256_mul_ps(_mm256_load_ps(x + i), vx));
+            _mm256_store_ps(y + i, _mm256_mul_ps(_mm256_load_ps(y + i), vy));
+        }
+    }
+
+    GUM_TARGET("avx2")
+    static void multiply_add(float* x, float* y, const float* vx, const float* vy, float dt, std::size_t first, std::size_t last) {
+        auto step = _mm256_set1_ps(dt);
+        for(auto i = first; i < last; i += 8) {
+            _mm256_store_ps(x + i, _mm256_add_ps(_mm256_load_ps(x + i), _mm256_mul_ps(_mm256_load_ps(vx + i), step)));
+            _mm256_store_ps(y + i, _mm256_add_ps(_mm256_load_ps(y + i), _mm256_mul_ps(_mm256_load_ps(vy + i), step)));
+        }
+    }
+
+    GUM_TARGET("avx2")
+    static void dot(const float* x, const float* y, const float* ox, const float* oy, float* out, std::size_t first, std::size_t last) {
+        for(auto i = first; i < last; i += 8) {
+            auto a = _mm256_mul_ps(_mm256_load_ps(x + i), _mm256_load_ps(ox + i));
+            auto b = _mm256_mul_ps(_mm256_load_ps(y + i), _mm256_load_ps(oy + i));
+            _mm256_storeu_ps(out + i, _mm256_add_ps(a, b));
+        }
+    }
+
+    GUM_TARGET("avx2")
+    static __m256 squared(const float* x, const float* y, __m256 px, __m256 py, std::size_t i) {
+        auto dx = _mm256_sub_ps(_mm256_load_ps(x + i), px);
+        auto dy = _mm256_sub_ps(_mm256_load_ps(y + i), py);
+        return _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+    }
+
+    GUM_TARGET("avx2")
+    static void distance_squared(const float* x, const float* y, float px, float py, float* out, std::size_t first, std::size_t last) {
+        auto vx = _mm256_set1_ps(px);
+        auto vy = _mm256_set1_ps(py);
+        for(auto i = first; i < last; i += 8) {
+            _mm256_storeu_ps(out + i, squared(x, y, vx, vy, i));
+        }
+    }
+
+    GUM_TARGET("avx2")
+    static void clamp(float* x, float* y, float x1, float y1, float x2, float y2, std::size_t first, std::size_t last) {
+        auto left = _mm256_set1_ps(x1);
+        auto top = _mm256_set1_ps(y1);
+        auto right = _mm256_set1_ps(x2);
+        auto bottom = _mm256_set1_ps(y2);
+        for(auto i = first; i < last; i += 8) {
+            _mm256_store_ps(x + i, _mm256_min_ps(_mm256_max_ps(_mm256_load_ps(x + i), left), right));
+            _mm256_store_ps(y + i, _mm256_min_ps(_mm256_max_ps(_mm256_load_ps(y + i), top), bottom));
+        }
+    }
+
+    GUM_TARGET("avx2")
+    static void within(const float* x, const float* y, float px, float py, float limit, uint64_t* mask, std::size_t first, std::size_t last) {
+        auto vx = _mm256_set1_ps(px);
+        auto vy = _mm256_set1_ps(py);
+        auto bound = _mm256_set1_ps(limit);
+        for(auto i = first; i < last; i += 8) {
+            auto inside = _mm256_cmp_ps(squared(x, y, vx, vy, i), bound, _CMP_LT_OQ);
+            mask[i / 64] |= static_cast<uint64_t>(_mm256_movemask_ps(inside)) << (i % 64);
+        }
+    }
+};
+#endif // GUM_HAS_X86_SIMD
+
+template<typename Kernels>
+inline vector_kernel_table make_vector_kernels() noexcept {
+    return {
+        &Kernels::add,
+        &Kernels::translate,
+        &Kernels::scale,
+        &Kernels::multiply_add,
+        &Kernels::dot,
+        &Kernels::distance_squared,
+        &Kernels::clamp,
+        &Kernels::within
+    };
+}
+
+inline const vector_kernel_table& scalar_vector_kernel_table() noexcept {
+    static const vector_kernel_table table = make_vector_kernels<scalar_vector_kernels>();
+    return table;
+}
+
+// the kernels for the best instruction set available, picked once
+inline const vector_kernel_table& vector_kernels() noexcept {
+#if defined(GUM_HAS_X86_SIMD)
+    static const vector_kernel_table table = simd() == simd_level::avx2 ? make_vector_kernels<avx_vector_kernels>() :
+                                             simd() == simd_level::sse41 ? make_vector_kernels<sse_vector_kernels>() :
+                                             make_vector_kernels<scalar_vector_kernels>();
+    return table;
+#else
+    return scalar_vector_kernel_table();
+#endif
+}
+} // detail
+} // sdl
+
+#endif // GUM_DETAIL_VECTOR_KERNELS_HPP
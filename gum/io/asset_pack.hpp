@@ -0,0 +1,234 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_IO_ASSET_PACK_HPP
+#define GUM_IO_ASSET_PACK_HPP
+
+#include <gum/core/error.hpp>
+#include <gum/detail/mapped_file.hpp>
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace sdl {
+namespace detail {
+// 64-bit FNV-1a, the pack tool hashes every file's contents with it
+inline uint64_t fnv1a(const void* data, std::size_t size) noexcept {
+    auto bytes = static_cast<const unsigned char*>(data);
+    uint64_t result = 14695981039346656037ULL;
+    for(std::size_t i = 0; i < size; ++i) {
+        result ^= bytes[i];
+        result *= 1099511628211ULL;
+    }
+    return result;
+}
+
+inline uint32_t read_le32(const unsigned char* p) noexcept {
+    uint32_t result;
+    std::memcpy(&result, p, sizeof(result));
+    return SDL_SwapLE32(result);
+}
+
+inline uint64_t read_le64(const unsigned char* p) noexcept {
+    uint64_t result;
+    std::memcpy(&result, p, sizeof(result));
+    return SDL_SwapLE64(result);
+}
+} // detail
+
+// a file stored in an asset_pack, the pointers refer to the mapped pack
+struct asset {
+    const char* name = nullptr; // not null terminated
+    std::size_t name_size = 0;
+    const void* data = nullptr;
+    std::size_t size = 0;
+    uint64_t hash = 0;
+};
+
+// a single file holding many assets, made with pack_tool.py. All little endian:
+//
+// header: char magic[4] = "GUMP", uint32 version, uint32 count, uint32 names_size
+// index:  count entries sorted by name of
+//         uint64 offset, uint64 size, uint64 hash, uint32 name_offset, uint32 name_size
+// names:  names_size bytes of names without terminators
+// data:   the contents of every file, offsets are from the start of the pack
+//
+// The pack is mapped into memory once and assets are read straight from it
+struct asset_pack {
+private:
+    detail::mapped_file file;
+    std::vector<asset> assets_;
+
+    static const std::size_t header_size = 16;
+    static const std::size_t entry_size = 32;
+
+    struct name_less {
+        static bool less(const char* lhs, std::size_t lhs_size, const char* rhs, std::size_t rhs_size) noexcept {
+            int result = std::memcmp(lhs, rhs, std::min(lhs_size, rhs_size));
+            return result < 0 || (result == 0 && lhs_size < rhs_size);
+        }
+
+        bool operator()(const asset& lhs, const std::string& rhs) const noexcept {
+            return less(lhs.name, lhs.name_size, rhs.data(), rhs.size());
+        }
+
+        bool operator()(const asset& lhs, const asset& rhs) const noexcept {
+            return less(lhs.name, lhs.name_size, rhs.name, rhs.name_size);
+        }
+    };
+
+    bool parse() {
+        auto data = file.data();
+        auto size = file.size();
+        if(size < header_size || std::memcmp(data, "GUMP", 4) != 0 || detail::read_le32(data + 4) != 1) {
+            return false;
+        }
+
+        uint64_t count = detail::read_le32(data + 8);
+        uint64_t names_size = detail::read_le32(data + 12);
+        uint64_t names_offset = header_size + count * entry_size;
+        if(names_offset + names_size > size) {
+            return false;
+        }
+
+        assets_.resize(count);
+        for(std::size_t i = 0; i < count; ++i) {
+            auto entry = data + header_size + i * entry_size;
+            uint64_t offset = detail::read_le64(entry);
+            uint64_t length = detail::read_le64(entry + 8);
+            uint64_t name_offset = detail::read_le32(entry + 24);
+            uint64_t name_size = detail::read_le32(entry + 28);
+            if(offset > size || length > size - offset || name_offset + name_size > names_size) {
+                return false;
+            }
+
+            auto&& result = assets_[i];
+            result.name = reinterpret_cast<const char*>(data + names_offset + name_offset);
+            result.name_size = static_cast<std::size_t>(name_size);
+            result.data = data + offset;
+            result.size = static_cast<std::size_t>(length);
+            result.hash = detail::read_le64(entry + 16);
+
+            // find relies on the names being sorted and unique
+            if(i != 0 && !name_less()(assets_[i - 1], result)) {
+                return false;
+            }
+        }
+        return true;
+    }
+public:
+    asset_pack() = default;
+
+    asset_pack(const std::string& filename) {
+        open(filename);
+    }
+
+    bool open(const std::string& filename) {
+        close();
+        if(!file.open(filename)) {
+            GUM_ERROR_HANDLER(false);
+        }
+
+        if(!parse()) {
+            close();
+            SDL_SetError("'%s' is not a valid asset pack", filename.c_str());
+            GUM_ERROR_HANDLER(false);
+        }
+        return true;
+    }
+
+    void close() noexcept {
+        assets_.clear();
+        file.close();
+    }
+
+    explicit operator bool() const noexcept {
+        return static_cast<bool>(file);
+    }
+
+    // binary search over the sorted index, nullptr if there's no such asset
+    const asset* find(const std::string& name) const noexcept {
+        auto it = std::lower_bound(assets_.begin(), assets_.end(), name, name_less());
+        if(it == assets_.end() || it->name_size != name.size() || std::memcmp(it->name, name.data(), name.size()) != 0) {
+            return nullptr;
+        }
+        return &*it;
+    }
+
+    bool contains(const std::string& name) const noexcept {
+        return find(name) != nullptr;
+    }
+
+    // a read only SDL_RWops over the asset's bytes in the pack, nothing is copied.
+    // The caller closes it, or passes it to something that does such as surface::load_rw
+    SDL_RWops* rwops(const std::string& name) const {
+        auto* result = find(name);
+        if(result == nullptr) {
+            SDL_SetError("asset '%s' not found", name.c_str());
+            GUM_ERROR_HANDLER(nullptr);
+        }
+        return rwops(*result);
+    }
+
+    SDL_RWops* rwops(const asset& entry) const {
+        if(entry.size > static_cast<std::size_t>(INT_MAX)) {
+            SDL_SetError("asset is too large for an SDL_RWops");
+            GUM_ERROR_HANDLER(nullptr);
+        }
+
+        auto* result = SDL_RWFromConstMem(entry.data, static_cast<int>(entry.size));
+        if(result == nullptr) {
+            GUM_ERROR_HANDLER(nullptr);
+        }
+        return result;
+    }
+
+    // checks the contents against the hash stored in the index
+    bool verify(const asset& entry) const noexcept {
+        return detail::fnv1a(entry.data, entry.size) == entry.hash;
+    }
+
+    bool verify() const noexcept {
+        for(auto&& entry : assets_) {
+            if(!verify(entry)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const std::vector<asset>& assets() const noexcept {
+        return assets_;
+    }
+
+    std::size_t size() const noexcept {
+        return assets_.size();
+    }
+
+    bool empty() const noexcept {
+        return assets_.empty();
+    }
+};
+} // sdl
+
+#endif // GUM_IO_ASSET_PACK_HPP
@@ -23,5 +23,6 @@
 #include <gum/platform/name.hpp>
 #include <gum/platform/cpu.hpp>
 #include <gum/platform/endian.hpp>
+#include <gum/platform/thread_pool.hpp>
 
 #endif // GUM_PLATFORM_HPP
@@ -31,6 +31,14 @@ inline bool has_avx() noexcept {
     return SDL_HasAVX() == SDL_TRUE;
 }
 
+inline bool has_avx2() noexcept {
+#if SDL_VERSION_ATLEAST(2, 0, 4)
+    return SDL_HasAVX2() == SDL_TRUE;
+#else
+    return false;
+#endif
+}
+
 inline bool has_altivec() noexcept {
     return SDL_HasAltiVec() == SDL_TRUE;
 }
@@ -0,0 +1,204 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_PLATFORM_THREAD_POOL_HPP
+#define GUM_PLATFORM_THREAD_POOL_HPP
+
+#include <gum/platform/cpu.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace sdl {
+struct thread_pool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping = false;
+
+    // the pool whose worker is running on this thread, if any
+    static thread_pool*& current() noexcept {
+        static thread_local thread_pool* pool = nullptr;
+        return pool;
+    }
+
+    void work() {
+        current() = this;
+        for(;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                available.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if(tasks.empty()) {
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+public:
+    // by default one thread less than the number of cores since the calling
+    // thread takes part in parallel_for
+    explicit thread_pool(unsigned threads = 0) {
+        if(threads == 0) {
+            auto cores = logical_cpu_cores();
+            threads = cores > 1 ? static_cast<unsigned>(cores - 1) : 1u;
+        }
+
+        workers.reserve(threads);
+        for(unsigned i = 0; i < threads; ++i) {
+            workers.emplace_back([this] { work(); });
+        }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        available.notify_all();
+        for(auto&& worker : workers) {
+            worker.join();
+        }
+    }
+
+    std::size_t size() const noexcept {
+        return workers.size();
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(std::move(task));
+        }
+        available.notify_one();
+    }
+
+    // splits [0, count) into at most `chunks` contiguous ranges and calls f(first, last, chunk)
+    // for each of them, with the calling thread taking the first chunk. Blocks until done.
+    // The first exception thrown by f is rethrown once every chunk has finished.
+    template<typename Function>
+    void parallel_for(std::size_t count, std::size_t chunks, Function f) {
+        if(count == 0) {
+            return;
+        }
+
+        if(chunks > count) {
+            chunks = count;
+        }
+
+        auto step = count / chunks;
+        auto extra = count % chunks;
+        auto range = [&](std::size_t chunk) {
+            auto first = chunk * step + (chunk < extra ? chunk : extra);
+            return std::make_pair(first, first + step + (chunk < extra ? 1 : 0));
+        };
+
+        // a worker waiting on its own pool could take every thread down with it,
+        // so nested calls run their chunks in order on the calling worker
+        if(chunks < 2 || current() == this) {
+            for(std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                auto r = range(chunk);
+                f(r.first, r.second, chunk);
+            }
+            return;
+        }
+
+        std::mutex done_mutex;
+        std::condition_variable done;
+        std::size_t remaining = chunks - 1;
+#if defined(GUM_HAS_EXCEPTIONS)
+        std::exception_ptr error;
+#endif
+        auto run = [&](std::size_t chunk) {
+            auto r = range(chunk);
+#if defined(GUM_HAS_EXCEPTIONS)
+            try {
+                f(r.first, r.second, chunk);
+            }
+            catch(...) {
+                std::lock_guard<std::mutex> lock(done_mutex);
+                if(!error) {
+                    error = std::current_exception();
+                }
+            }
+#else
+            f(r.first, r.second, chunk);
+#endif
+        };
+        auto finish = [&] {
+            std::lock_guard<std::mutex> lock(done_mutex);
+            if(--remaining == 0) {
+                done.notify_one();
+            }
+        };
+
+        std::size_t chunk = 1;
+#if defined(GUM_HAS_EXCEPTIONS)
+        try {
+#endif
+            for(; chunk < chunks; ++chunk) {
+                submit([&run, &finish, chunk] {
+                    run(chunk);
+                    finish();
+                });
+            }
+#if defined(GUM_HAS_EXCEPTIONS)
+        }
+        catch(...) {
+            // whatever couldn't be queued is done here instead so the
+            // queued chunks never outlive the state they refer to
+            for(; chunk < chunks; ++chunk) {
+                run(chunk);
+                finish();
+            }
+        }
+#endif
+
+        run(0);
+        std::unique_lock<std::mutex> lock(done_mutex);
+        done.wait(lock, [&] { return remaining == 0; });
+#if defined(GUM_HAS_EXCEPTIONS)
+        if(error) {
+            std::rethrow_exception(error);
+        }
+#endif
+    }
+
+    template<typename Function>
+    void parallel_for(std::size_t count, Function f) {
+        parallel_for(count, workers.size() + 1, std::move(f));
+    }
+};
+} // sdl
+
+#endif // GUM_PLATFORM_THREAD_POOL_HPP
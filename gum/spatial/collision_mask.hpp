@@ -0,0 +1,333 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_SPATIAL_COLLISION_MASK_HPP
+#define GUM_SPATIAL_COLLISION_MASK_HPP
+
+#include <gum/core/error.hpp>
+#include <gum/detail/aabb.hpp>
+#include <gum/detail/simd.hpp>
+#include <gum/video/rect.hpp>
+#include <gum/video/sprite.hpp>
+#include <gum/video/surface.hpp>
+#include <gum/video/vector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace sdl {
+// which pixels of an image are solid, packed into one bit per pixel. Every row is
+// made of 64-bit words with the leftmost pixel in the lowest bit, followed by a
+// zeroed word so that 64 bits starting anywhere in a row can be read without checks
+struct collision_mask {
+private:
+    std::vector<uint64_t> bits;
+    std::size_t stride = 0;  // words per row
+    int width_ = 0;
+    int height_ = 0;
+
+    // the part of two masks that overlaps, in the coordinates of each mask
+    struct overlap {
+        const uint64_t* a;
+        const uint64_t* b;
+        std::size_t a_stride;
+        std::size_t b_stride;
+        int ax;
+        int bx;
+        int width;
+        int rows;
+    };
+
+    const uint64_t* row(int y) const noexcept {
+        return bits.data() + static_cast<std::size_t>(y) * stride;
+    }
+
+    static uint64_t fetch(const uint64_t* row, int bit) noexcept {
+        auto word = bit / 64;
+        auto shift = bit % 64;
+        if(shift == 0) {
+            return row[word];
+        }
+        return (row[word] >> shift) | (row[word + 1] << (64 - shift));
+    }
+
+    // the rest of a row after the first `first` bits, 64 at a time
+    static bool row_overlaps(const uint64_t* a, int ax, const uint64_t* b, int bx, int first, int width) noexcept {
+        for(int x = first; x < width; x += 64) {
+            auto common = fetch(a, ax + x) & fetch(b, bx + x);
+            if(width - x < 64) {
+                common &= (uint64_t(1) << (width - x)) - 1;
+            }
+
+            if(common != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool overlaps_scalar(const overlap& o) noexcept {
+        for(int y = 0; y < o.rows; ++y) {
+            if(row_overlaps(o.a + y * o.a_stride, o.ax, o.b + y * o.b_stride, o.bx, 0, o.width)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+#if defined(GUM_HAS_X86_SIMD)
+    // shifting a lane by 64 gives zero, so unshifted rows need no special case
+    GUM_TARGET("sse4.1")
+    static __m128i load_sse41(const uint64_t* row, int bit) noexcept {
+        auto* words = reinterpret_cast<const __m128i*>(row + bit / 64);
+        auto low = _mm_loadu_si128(words);
+        auto high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + bit / 64 + 1));
+        auto shift = bit % 64;
+        return _mm_or_si128(_mm_srl_epi64(low, _mm_cvtsi32_si128(shift)), _mm_sll_epi64(high, _mm_cvtsi32_si128(64 - shift)));
+    }
+
+    GUM_TARGET("sse4.1")
+    static bool overlaps_sse41(const overlap& o) noexcept {
+        auto blocks = o.width / 128 * 128;
+        for(int y = 0; y < o.rows; ++y) {
+            auto* a = o.a + y * o.a_stride;
+            auto* b = o.b + y * o.b_stride;
+            for(int x = 0; x < blocks; x += 128) {
+                if(!_mm_testz_si128(load_sse41(a, o.ax + x), load_sse41(b, o.bx + x))) {
+                    return true;
+                }
+            }
+
+            if(row_overlaps(a, o.ax, b, o.bx, blocks, o.width)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    GUM_TARGET("avx2")
+    static __m256i load_avx2(const uint64_t* row, int bit) noexcept {
+        auto low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + bit / 64));
+        auto high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + bit / 64 + 1));
+        auto shift = bit % 64;
+        return _mm256_or_si256(_mm256_srl_epi64(low, _mm_cvtsi32_si128(shift)),
+                               _mm256_sll_epi64(high, _mm_cvtsi32_si128(64 - shift)));
+    }
+
+    GUM_TARGET("avx2")
+    static bool overlaps_avx2(const overlap& o) noexcept {
+        auto blocks = o.width / 256 * 256;
+        for(int y = 0; y < o.rows; ++y) {
+            auto* a = o.a + y * o.a_stride;
+            auto* b = o.b + y * o.b_stride;
+            for(int x = 0; x < blocks; x += 256) {
+                if(!_mm256_testz_si256(load_avx2(a, o.ax + x), load_avx2(b, o.bx + x))) {
+                    return true;
+                }
+            }
+
+            if(row_overlaps(a, o.ax, b, o.bx, blocks, o.width)) {
+                return true;
+            }
+        }
+        return false;
+    }
+#endif // GUM_HAS_X86_SIMD
+
+    void build(SDL_Surface* image, const rect& area, uint8_t threshold) {
+        // the alpha is read from RGBA8888 pixels, where it's always the low byte
+        std::unique_ptr<SDL_Surface, detail::surface_deleter> converted;
+        if(image->format->format != SDL_PIXELFORMAT_RGBA8888) {
+            converted.reset(SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_RGBA8888, 0));
+            if(converted == nullptr) {
+                GUM_ERROR_HANDLER_VOID();
+            }
+            image = converted.get();
+        }
+
+        bool locked = SDL_MUSTLOCK(image);
+        if(locked && SDL_LockSurface(image) != 0) {
+            GUM_ERROR_HANDLER_VOID();
+        }
+
+        auto* pixels = static_cast<const unsigned char*>(image->pixels);
+        for(int y = 0; y < height_; ++y) {
+            auto* source = reinterpret_cast<const uint32_t*>(pixels + (area.y + y) * image->pitch) + area.x;
+            for(int x = 0; x < width_; ++x) {
+                if((source[x] & 0xff) >= threshold) {
+                    bits[y * stride + x / 64] |= uint64_t(1) << (x % 64);
+                }
+            }
+        }
+
+        if(locked) {
+            SDL_UnlockSurface(image);
+        }
+    }
+
+    static rect common_area(const rect& a, const rect& b) noexcept {
+        return detail::overlaps(a, b) ? a.intersection(b) : rect();
+    }
+
+    // the region of the mask, clamped to it
+    rect clamp(const rect& region) const noexcept {
+        return common_area(region, rect(0, 0, width_, height_));
+    }
+public:
+    collision_mask() = default;
+
+    // a mask with every pixel empty
+    collision_mask(int width, int height) {
+        resize(width, height);
+    }
+
+    // pixels with an alpha of at least the threshold are solid
+    explicit collision_mask(const surface& image, uint8_t threshold = 128):
+        collision_mask(image, rect(0, 0, image.size().x, image.size().y), threshold) {}
+
+    // only the area of the image is used, e.g. a single frame of a sprite sheet
+    collision_mask(const surface& image, const rect& area, uint8_t threshold = 128) {
+        auto size = image.size();
+        auto region = common_area(area, rect(0, 0, size.x, size.y));
+        resize(region.w, region.h);
+        if(!region.empty()) {
+            build(image.data(), region, threshold);
+        }
+    }
+
+    // copies the area of another mask
+    collision_mask(const collision_mask& other, const rect& area) {
+        auto region = other.clamp(area);
+        resize(region.w, region.h);
+        for(int y = 0; y < height_; ++y) {
+            auto* source = other.row(region.y + y);
+            for(std::size_t word = 0; word * 64 < static_cast<std::size_t>(width_); ++word) {
+                auto value = fetch(source, region.x + static_cast<int>(word * 64));
+                auto remaining = width_ - static_cast<int>(word * 64);
+                if(remaining < 64) {
+                    value &= (uint64_t(1) << remaining) - 1;
+                }
+                bits[y * stride + word] = value;
+            }
+        }
+    }
+
+    // every pixel becomes empty
+    void resize(int width, int height) {
+        width_ = width > 0 && height > 0 ? width : 0;
+        height_ = width > 0 && height > 0 ? height : 0;
+        stride = (static_cast<std::size_t>(width_) + 63) / 64 + 1;
+        bits.assign(stride * static_cast<std::size_t>(height_), 0);
+    }
+
+    int width() const noexcept {
+        return width_;
+    }
+
+    int height() const noexcept {
+        return height_;
+    }
+
+    vector size() const noexcept {
+        return { width_, height_ };
+    }
+
+    bool solid(int x, int y) const noexcept {
+        if(x < 0 || y < 0 || x >= width_ || y >= height_) {
+            return false;
+        }
+        return (row(y)[x / 64] >> (x % 64)) & 1;
+    }
+
+    void solid(int x, int y, bool value) noexcept {
+        if(x < 0 || y < 0 || x >= width_ || y >= height_) {
+            return;
+        }
+
+        auto&& word = bits[y * stride + x / 64];
+        auto bit = uint64_t(1) << (x % 64);
+        word = value ? word | bit : word & ~bit;
+    }
+
+    // the number of solid pixels
+    std::size_t count() const noexcept {
+        std::size_t result = 0;
+        for(auto word : bits) {
+            for(; word != 0; word &= word - 1) {
+                ++result;
+            }
+        }
+        return result;
+    }
+
+    // checks whether a region of this mask placed at position has a solid pixel in
+    // common with a region of another mask placed at other_position. The regions
+    // let a mask of a whole sprite sheet be tested one frame at a time
+    bool overlaps(const rect& region, const vector& position, const collision_mask& other,
+                  const rect& other_region, const vector& other_position) const noexcept {
+        auto a = clamp(region);
+        auto b = other.clamp(other_region);
+        // the clamped regions stay where they were relative to the position
+        rect a_area(position.x + a.x - region.x, position.y + a.y - region.y, a.w, a.h);
+        rect b_area(other_position.x + b.x - other_region.x, other_position.y + b.y - other_region.y, b.w, b.h);
+        if(!detail::overlaps(a_area, b_area)) {
+            return false;
+        }
+
+        auto common = a_area.intersection(b_area);
+        overlap o;
+        o.ax = a.x + common.x - a_area.x;
+        o.bx = b.x + common.x - b_area.x;
+        o.a = row(a.y + common.y - a_area.y);
+        o.b = other.row(b.y + common.y - b_area.y);
+        o.a_stride = stride;
+        o.b_stride = other.stride;
+        o.width = common.w;
+        o.rows = common.h;
+        switch(detail::simd()) {
+#if defined(GUM_HAS_X86_SIMD)
+        case detail::simd_level::avx2:
+            return overlaps_avx2(o);
+        case detail::simd_level::sse41:
+            return overlaps_sse41(o);
+#endif // GUM_HAS_X86_SIMD
+        default:
+            return overlaps_scalar(o);
+        }
+    }
+
+    // the whole of both masks, with the other mask offset relative to this one
+    bool overlaps(const collision_mask& other, const vector& offset) const noexcept {
+        return overlaps(rect(0, 0, width_, height_), vector(0, 0), other, rect(0, 0, other.width_, other.height_), offset);
+    }
+
+    bool overlaps(const collision_mask& other, int dx, int dy) const noexcept {
+        return overlaps(other, vector(dx, dy));
+    }
+};
+
+// tests two sprites using masks of their whole textures, with the subtexture of each sprite
+// picking its part of the mask. Rotation, flipping and scaling aren't taken into account
+inline bool collides(const sprite& lhs, const collision_mask& lhs_mask, const sprite& rhs, const collision_mask& rhs_mask) noexcept {
+    return lhs_mask.overlaps(lhs.subtexture(), lhs.position(), rhs_mask, rhs.subtexture(), rhs.position());
+}
+} // sdl
+
+#endif // GUM_SPATIAL_COLLISION_MASK_HPP
@@ -0,0 +1,316 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_SPATIAL_QUADTREE_HPP
+#define GUM_SPATIAL_QUADTREE_HPP
+
+#include <gum/detail/aabb.hpp>
+#include <gum/video/rect.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace sdl {
+// a quadtree where every node accepts objects reaching up to half a cell past its edges.
+// this lets objects be placed directly from their size and centre without walking the
+// tree, and moving objects rarely have to change nodes
+struct loose_quadtree {
+private:
+    struct entry {
+        rect area;
+        int level = 0;
+        int x = 0;
+        int y = 0;
+        uint32_t slot = 0;  // position in the node's ids
+        bool alive = false;
+    };
+
+    struct node {
+        std::vector<uint32_t> ids;
+        std::size_t total = 0;  // objects in this node and every node below it
+        rect loose;             // the cell grown by half its size on every side
+    };
+
+    rect world;
+    int levels = 6;
+    std::vector<node> nodes;    // every level laid out one after another in row order
+    std::vector<entry> entries; // indexed by id
+    std::size_t count = 0;
+
+    static std::size_t level_offset(int level) noexcept {
+        return ((std::size_t(1) << (2 * level)) - 1) / 3;
+    }
+
+    std::size_t index(int level, int x, int y) const noexcept {
+        return level_offset(level) + (static_cast<std::size_t>(y) << level) + static_cast<std::size_t>(x);
+    }
+
+    rect cell(int level, int x, int y) const noexcept {
+        auto n = 1LL << level;
+        auto x1 = world.x + static_cast<int>(world.w * x / n);
+        auto y1 = world.y + static_cast<int>(world.h * y / n);
+        auto x2 = world.x + static_cast<int>(world.w * (x + 1LL) / n);
+        auto y2 = world.y + static_cast<int>(world.h * (y + 1LL) / n);
+        return { x1, y1, x2 - x1, y2 - y1 };
+    }
+
+
+    void place(entry& e) const noexcept {
+        e.level = 0;
+        e.x = 0;
+        e.y = 0;
+        auto cx = e.area.x + e.area.w / 2;
+        auto cy = e.area.y + e.area.h / 2;
+
+        // objects centred outside of the world stay in the root which is always searched
+        if(!detail::contains(world, cx, cy)) {
+            return;
+        }
+
+        // the deepest level where the object isn't bigger than a cell
+        while(e.level < levels - 1 &&
+              e.area.w <= (world.w >> (e.level + 1)) && e.area.h <= (world.h >> (e.level + 1))) {
+            ++e.level;
+        }
+
+        auto n = 1LL << e.level;
+        e.x = static_cast<int>((cx - world.x) * n / world.w);
+        e.y = static_cast<int>((cy - world.y) * n / world.h);
+    }
+
+    void link(uint32_t id, entry& e) {
+        auto&& ids = nodes[index(e.level, e.x, e.y)].ids;
+        e.slot = static_cast<uint32_t>(ids.size());
+        ids.push_back(id);
+        for(int level = e.level, x = e.x, y = e.y; level >= 0; --level, x /= 2, y /= 2) {
+            ++nodes[index(level, x, y)].total;
+        }
+    }
+
+    void unlink(const entry& e) {
+        auto&& ids = nodes[index(e.level, e.x, e.y)].ids;
+        ids[e.slot] = ids.back();
+        entries[ids[e.slot]].slot = e.slot;
+        ids.pop_back();
+        for(int level = e.level, x = e.x, y = e.y; level >= 0; --level, x /= 2, y /= 2) {
+            --nodes[index(level, x, y)].total;
+        }
+    }
+
+    template<typename Function>
+    void visit(const rect& area, int level, int x, int y, Function& f) const {
+        auto&& n = nodes[index(level, x, y)];
+        if(n.total == 0 || (level != 0 && !detail::overlaps(n.loose, area))) {
+            return;
+        }
+
+        for(auto&& id : n.ids) {
+            if(detail::overlaps(entries[id].area, area)) {
+                f(id);
+            }
+        }
+
+        if(level + 1 < levels) {
+            for(int i = 0; i < 4; ++i) {
+                visit(area, level + 1, x * 2 + (i & 1), y * 2 + (i >> 1), f);
+            }
+        }
+    }
+public:
+    // depth is the number of levels below the root
+    explicit loose_quadtree(const rect& world, int depth = 5): world(world) {
+        levels = depth < 0 ? 1 : depth > 10 ? 11 : depth + 1;
+        if(this->world.w < 1) {
+            this->world.w = 1;
+        }
+
+        if(this->world.h < 1) {
+            this->world.h = 1;
+        }
+        nodes.resize(level_offset(levels));
+        for(int level = 0; level < levels; ++level) {
+            for(int y = 0; y < (1 << level); ++y) {
+                for(int x = 0; x < (1 << level); ++x) {
+                    auto c = cell(level, x, y);
+                    nodes[index(level, x, y)].loose = rect(c.x - c.w / 2 - 1, c.y - c.h / 2 - 1, c.w * 2 + 2, c.h * 2 + 2);
+                }
+            }
+        }
+    }
+
+    rect bounds() const noexcept {
+        return world;
+    }
+
+    int depth() const noexcept {
+        return levels - 1;
+    }
+
+    // ids index the storage directly so they should be small and dense, e.g. an index into an array
+    void insert(uint32_t id, const rect& area) {
+        if(id >= entries.size()) {
+            entries.resize(id + 1);
+        }
+
+        auto&& e = entries[id];
+        if(e.alive) {
+            move(id, area);
+            return;
+        }
+
+        e.area = area;
+        e.alive = true;
+        place(e);
+        link(id, e);
+        ++count;
+    }
+
+    // only changes nodes when the object left the loose bounds of its node or changed size a lot
+    void move(uint32_t id, const rect& area) {
+        if(id >= entries.size() || !entries[id].alive) {
+            insert(id, area);
+            return;
+        }
+
+        auto&& e = entries[id];
+        entry updated = e;
+        updated.area = area;
+        place(updated);
+        if(updated.level != e.level || updated.x != e.x || updated.y != e.y) {
+            unlink(e);
+            e = updated;
+            link(id, e);
+        }
+        else {
+            e.area = area;
+        }
+    }
+
+    void erase(uint32_t id) {
+        if(id < entries.size() && entries[id].alive) {
+            unlink(entries[id]);
+            entries[id].alive = false;
+            --count;
+        }
+    }
+
+    void clear() noexcept {
+        for(auto&& n : nodes) {
+            n.ids.clear();
+            n.total = 0;
+        }
+
+        for(auto&& e : entries) {
+            e.alive = false;
+        }
+        count = 0;
+    }
+
+    bool contains(uint32_t id) const noexcept {
+        return id < entries.size() && entries[id].alive;
+    }
+
+    rect bounds(uint32_t id) const noexcept {
+        return contains(id) ? entries[id].area : rect();
+    }
+
+    std::size_t size() const noexcept {
+        return count;
+    }
+
+    bool empty() const noexcept {
+        return count == 0;
+    }
+
+    // calls f(id) once for every object overlapping the area
+    template<typename Function>
+    void query(const rect& area, Function f) const {
+        if(area.w > 0 && area.h > 0) {
+            visit(area, 0, 0, 0, f);
+        }
+    }
+
+    void query(const rect& area, std::vector<uint32_t>& result) const {
+        result.clear();
+        query(area, [&result](uint32_t id) { result.push_back(id); });
+    }
+
+    // calls f(id) for every object containing the point, e.g. for mouse picking
+    template<typename Function>
+    void pick(int x, int y, Function f) const {
+        query(rect(x, y, 1, 1), f);
+    }
+
+    void pick(int x, int y, std::vector<uint32_t>& result) const {
+        result.clear();
+        pick(x, y, [&result](uint32_t id) { result.push_back(id); });
+    }
+
+    // calls f(a, b) once for every pair of overlapping objects with a < b
+    template<typename Function>
+    void pairs(Function f) const {
+        // objects are never bigger than their cell, so an object can only overlap objects of the
+        // same or a shallower level in the cells next to its own or next to one of its ancestors.
+        // pairs across levels are found from the deeper object and pairs on a level from the lower id
+        for(uint32_t id = 0; id < entries.size(); ++id) {
+            auto&& a = entries[id];
+            if(!a.alive) {
+                continue;
+            }
+
+            for(int level = 0; level <= a.level; ++level) {
+                auto shift = a.level - level;
+                auto n = 1 << level;
+                auto cx = a.x >> shift;
+                auto cy = a.y >> shift;
+                for(int y = cy - 1; y <= cy + 1; ++y) {
+                    for(int x = cx - 1; x <= cx + 1; ++x) {
+                        if(x < 0 || y < 0 || x >= n || y >= n) {
+                            continue;
+                        }
+
+                        for(auto&& other : nodes[index(level, x, y)].ids) {
+                            if(level == a.level && other <= id) {
+                                continue;
+                            }
+
+                            if(detail::overlaps(a.area, entries[other].area)) {
+                                if(id < other) {
+                                    f(id, other);
+                                }
+                                else {
+                                    f(other, id);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void pairs(std::vector<std::pair<uint32_t, uint32_t>>& result) const {
+        result.clear();
+        pairs([&result](uint32_t a, uint32_t b) { result.emplace_back(a, b); });
+    }
+};
+} // sdl
+
+#endif // GUM_SPATIAL_QUADTREE_HPP
@@ -0,0 +1,461 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_SPATIAL_RECT_ARRAY_HPP
+#define GUM_SPATIAL_RECT_ARRAY_HPP
+
+#include <gum/detail/aabb.hpp>
+#include <gum/detail/simd.hpp>
+#include <gum/video/rect.hpp>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sdl {
+// rectangles stored as separate arrays of x, y, w and h so that many of them
+// can be tested at once. The arrays are padded with empty rectangles to a
+// multiple of 8 which never intersect or contain anything
+struct rect_array {
+private:
+    using storage = std::vector<int, detail::aligned_allocator<int, 32>>;
+    storage xs;
+    storage ys;
+    storage ws;
+    storage hs;
+    std::size_t count = 0;
+
+    static std::size_t padded(std::size_t n) noexcept {
+        return (n + 7) & ~static_cast<std::size_t>(7);
+    }
+
+    static void prepare(std::vector<uint64_t>& mask, std::size_t n) {
+        mask.assign((n + 63) / 64, 0);
+    }
+
+    void intersects_scalar(const SDL_Rect& area, uint64_t* mask) const noexcept {
+        for(std::size_t i = 0; i < count; ++i) {
+            SDL_Rect r = { xs[i], ys[i], ws[i], hs[i] };
+            if(detail::overlaps(area, r)) {
+                mask[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+    }
+
+    void contains_scalar(int x, int y, uint64_t* mask) const noexcept {
+        for(std::size_t i = 0; i < count; ++i) {
+            SDL_Rect r = { xs[i], ys[i], ws[i], hs[i] };
+            if(detail::contains(r, x, y)) {
+                mask[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+    }
+
+    bool contains_any_scalar(int x, int y) const noexcept {
+        for(std::size_t i = 0; i < count; ++i) {
+            SDL_Rect r = { xs[i], ys[i], ws[i], hs[i] };
+            if(detail::contains(r, x, y)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    rect bounds_scalar() const noexcept {
+        int x1 = INT_MAX, y1 = INT_MAX, x2 = INT_MIN, y2 = INT_MIN;
+        for(std::size_t i = 0; i < count; ++i) {
+            if(ws[i] <= 0 || hs[i] <= 0) {
+                continue;
+            }
+
+            x1 = xs[i] < x1 ? xs[i] : x1;
+            y1 = ys[i] < y1 ? ys[i] : y1;
+            x2 = xs[i] + ws[i] > x2 ? xs[i] + ws[i] : x2;
+            y2 = ys[i] + hs[i] > y2 ? ys[i] + hs[i] : y2;
+        }
+        return x1 > x2 ? rect() : rect(x1, y1, x2 - x1, y2 - y1);
+    }
+
+#if defined(GUM_HAS_X86_SIMD)
+    GUM_TARGET("sse4.1")
+    void intersects_sse41(const SDL_Rect& area, uint64_t* mask) const noexcept {
+        auto zero = _mm_setzero_si128();
+        auto left = _mm_set1_epi32(area.x);
+        auto top = _mm_set1_epi32(area.y);
+        auto right = _mm_set1_epi32(area.x + area.w);
+        auto bottom = _mm_set1_epi32(area.y + area.h);
+        for(std::size_t i = 0; i < count; i += 4) {
+            auto x = _mm_load_si128(reinterpret_cast<const __m128i*>(&xs[i]));
+            auto y = _mm_load_si128(reinterpret_cast<const __m128i*>(&ys[i]));
+            auto w = _mm_load_si128(reinterpret_cast<const __m128i*>(&ws[i]));
+            auto h = _mm_load_si128(reinterpret_cast<const __m128i*>(&hs[i]));
+            auto hit = _mm_and_si128(_mm_cmpgt_epi32(w, zero), _mm_cmpgt_epi32(h, zero));
+            hit = _mm_and_si128(hit, _mm_cmpgt_epi32(_mm_add_epi32(x, w), left));
+            hit = _mm_and_si128(hit, _mm_cmpgt_epi32(right, x));
+            hit = _mm_and_si128(hit, _mm_cmpgt_epi32(_mm_add_epi32(y, h), top));
+            hit = _mm_and_si128(hit, _mm_cmpgt_epi32(bottom, y));
+            auto bits = static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(hit)));
+            mask[i / 64] |= bits << (i % 64);
+        }
+    }
+
+    GUM_TARGET("sse4.1")
+    __m128i contains_sse41(std::size_t i, __m128i px, __m128i py) const noexcept {
+        auto x = _mm_load_si128(reinterpret_cast<const __m128i*>(&xs[i]));
+        auto y = _mm_load_si128(reinterpret_cast<const __m128i*>(&ys[i]));
+        auto w = _mm_load_si128(reinterpret_cast<const __m128i*>(&ws[i]));
+        auto h = _mm_load_si128(reinterpret_cast<const __m128i*>(&hs[i]));
+        auto inside_x = _mm_andnot_si128(_mm_cmpgt_epi32(x, px), _mm_cmpgt_epi32(_mm_add_epi32(x, w), px));
+        auto inside_y = _mm_andnot_si128(_mm_cmpgt_epi32(y, py), _mm_cmpgt_epi32(_mm_add_epi32(y, h), py));
+        return _mm_and_si128(inside_x, inside_y);
+    }
+
+    GUM_TARGET("sse4.1")
+    void contains_sse41(int px, int py, uint64_t* mask) const noexcept {
+        auto x = _mm_set1_epi32(px);
+        auto y = _mm_set1_epi32(py);
+        for(std::size_t i = 0; i < count; i += 4) {
+            auto bits = static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(contains_sse41(i, x, y))));
+            mask[i / 64] |= bits << (i % 64);
+        }
+    }
+
+    GUM_TARGET("sse4.1")
+    bool contains_any_sse41(int px, int py) const noexcept {
+        auto x = _mm_set1_epi32(px);
+        auto y = _mm_set1_epi32(py);
+        for(std::size_t i = 0; i < count; i += 4) {
+            if(_mm_movemask_ps(_mm_castsi128_ps(contains_sse41(i, x, y))) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    GUM_TARGET("sse4.1")
+    rect bounds_sse41() const noexcept {
+        auto zero = _mm_setzero_si128();
+        auto highest = _mm_set1_epi32(INT_MAX);
+        auto lowest = _mm_set1_epi32(INT_MIN);
+        auto x1 = highest, y1 = highest, x2 = lowest, y2 = lowest;
+        for(std::size_t i = 0; i < count; i += 4) {
+            auto x = _mm_load_si128(reinterpret_cast<const __m128i*>(&xs[i]));
+            auto y = _mm_load_si128(reinterpret_cast<const __m128i*>(&ys[i]));
+            auto w = _mm_load_si128(reinterpret_cast<const __m128i*>(&ws[i]));
+            auto h = _mm_load_si128(reinterpret_cast<const __m128i*>(&hs[i]));
+            // empty rectangles are swapped out for values that don't affect the result
+            auto valid = _mm_and_si128(_mm_cmpgt_epi32(w, zero), _mm_cmpgt_epi32(h, zero));
+            x1 = _mm_min_epi32(x1, _mm_blendv_epi8(highest, x, valid));
+            y1 = _mm_min_epi32(y1, _mm_blendv_epi8(highest, y, valid));
+            x2 = _mm_max_epi32(x2, _mm_blendv_epi8(lowest, _mm_add_epi32(x, w), valid));
+            y2 = _mm_max_epi32(y2, _mm_blendv_epi8(lowest, _mm_add_epi32(y, h), valid));
+        }
+
+        alignas(16) int lanes[4][4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes[0]), x1);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes[1]), y1);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes[2]), x2);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes[3]), y2);
+        return reduce(lanes[0], lanes[1], lanes[2], lanes[3], 4);
+    }
+
+    GUM_TARGET("avx2")
+    void intersects_avx2(const SDL_Rect& area, uint64_t* mask) const noexcept {
+        auto zero = _mm256_setzero_si256();
+        auto left = _mm256_set1_epi32(area.x);
+        auto top = _mm256_set1_epi32(area.y);
+        auto right = _mm256_set1_epi32(area.x + area.w);
+        auto bottom = _mm256_set1_epi32(area.y + area.h);
+        for(std::size_t i = 0; i < count; i += 8) {
+            auto x = _mm256_load_si256(reinterpret_cast<const __m256i*>(&xs[i]));
+            auto y = _mm256_load_si256(reinterpret_cast<const __m256i*>(&ys[i]));
+            auto w = _mm256_load_si256(reinterpret_cast<const __m256i*>(&ws[i]));
+            auto h = _mm256_load_si256(reinterpret_cast<const __m256i*>(&hs[i]));
+            auto hit = _mm256_and_si256(_mm256_cmpgt_epi32(w, zero), _mm256_cmpgt_epi32(h, zero));
+            hit = _mm256_and_si256(hit, _mm256_cmpgt_epi32(_mm256_add_epi32(x, w), left));
+            hit = _mm256_and_si256(hit, _mm256_cmpgt_epi32(right, x));
+            hit = _mm256_and_si256(hit, _mm256_cmpgt_epi32(_mm256_add_epi32(y, h), top));
+            hit = _mm256_and_si256(hit, _mm256_cmpgt_epi32(bottom, y));
+            auto bits = static_cast<uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(hit)));
+            mask[i / 64] |= bits << (i % 64);
+        }
+    }
+
+    GUM_TARGET("avx2")
+    __m256i contains_avx2(std::size_t i, __m256i px, __m256i py) const noexcept {
+        auto x = _mm256_load_si256(reinterpret_cast<const __m256i*>(&xs[i]));
+        auto y = _mm256_load_si256(reinterpret_cast<const __m256i*>(&ys[i]));
+        auto w = _mm256_load_si256(reinterpret_cast<const __m256i*>(&ws[i]));
+        auto h = _mm256_load_si256(reinterpret_cast<const __m256i*>(&hs[i]));
+        auto inside_x = _mm256_andnot_si256(_mm256_cmpgt_epi32(x, px), _mm256_cmpgt_epi32(_mm256_add_epi32(x, w), px));
+        auto inside_y = _mm256_andnot_si256(_mm256_cmpgt_epi32(y, py), _mm256_cmpgt_epi32(_mm256_add_epi32(y, h), py));
+        return _mm256_and_si256(inside_x, inside_y);
+    }
+
+    GUM_TARGET("avx2")
+    void contains_avx2(int px, int py, uint64_t* mask) const noexcept {
+        auto x = _mm256_set1_epi32(px);
+        auto y = _mm256_set1_epi32(py);
+        for(std::size_t i = 0; i < count; i += 8) {
+            auto bits = static_cast<uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(contains_avx2(i, x, y))));
+            mask[i / 64] |= bits << (i % 64);
+        }
+    }
+
+    GUM_TARGET("avx2")
+    bool contains_any_avx2(int px, int py) const noexcept {
+        auto x = _mm256_set1_epi32(px);
+        auto y = _mm256_set1_epi32(py);
+        for(std::size_t i = 0; i < count; i += 8) {
+            auto inside = contains_avx2(i, x, y);
+            if(!_mm256_testz_si256(inside, inside)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    GUM_TARGET("avx2")
+    rect bounds_avx2() const noexcept {
+        auto zero = _mm256_setzero_si256();
+        auto highest = _mm256_set1_epi32(INT_MAX);
+        auto lowest = _mm256_set1_epi32(INT_MIN);
+        auto x1 = highest, y1 = highest, x2 = lowest, y2 = lowest;
+        for(std::size_t i = 0; i < count; i += 8) {
+            auto x = _mm256_load_si256(reinterpret_cast<const __m256i*>(&xs[i]));
+            auto y = _mm256_load_si256(reinterpret_cast<const __m256i*>(&ys[i]));
+            auto w = _mm256_load_si256(reinterpret_cast<const __m256i*>(&ws[i]));
+            auto h = _mm256_load_si256(reinterpret_cast<const __m256i*>(&hs[i]));
+            auto valid = _mm256_and_si256(_mm256_cmpgt_epi32(w, zero), _mm256_cmpgt_epi32(h, zero));
+            x1 = _mm256_min_epi32(x1, _mm256_blendv_epi8(highest, x, valid));
+            y1 = _mm256_min_epi32(y1, _mm256_blendv_epi8(highest, y, valid));
+            x2 = _mm256_max_epi32(x2, _mm256_blendv_epi8(lowest, _mm256_add_epi32(x, w), valid));
+            y2 = _mm256_max_epi32(y2, _mm256_blendv_epi8(lowest, _mm256_add_epi32(y, h), valid));
+        }
+
+        alignas(32) int lanes[4][8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[0]), x1);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[1]), y1);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[2]), x2);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[3]), y2);
+        return reduce(lanes[0], lanes[1], lanes[2], lanes[3], 8);
+    }
+
+    static rect reduce(const int* x1, const int* y1, const int* x2, const int* y2, int lanes) noexcept {
+        int left = INT_MAX, top = INT_MAX, right = INT_MIN, bottom = INT_MIN;
+        for(int i = 0; i < lanes; ++i) {
+            left = x1[i] < left ? x1[i] : left;
+            top = y1[i] < top ? y1[i] : top;
+            right = x2[i] > right ? x2[i] : right;
+            bottom = y2[i] > bottom ? y2[i] : bottom;
+        }
+        return left > right ? rect() : rect(left, top, right - left, bottom - top);
+    }
+#endif // GUM_HAS_X86_SIMD
+public:
+    rect_array() = default;
+
+    void reserve(std::size_t n) {
+        xs.reserve(padded(n));
+        ys.reserve(padded(n));
+        ws.reserve(padded(n));
+        hs.reserve(padded(n));
+    }
+
+    void push_back(const SDL_Rect& r) {
+        if(count == xs.size()) {
+            xs.resize(count + 8);
+            ys.resize(count + 8);
+            ws.resize(count + 8);
+            hs.resize(count + 8);
+        }
+
+        xs[count] = r.x;
+        ys[count] = r.y;
+        ws[count] = r.w;
+        hs[count] = r.h;
+        ++count;
+    }
+
+    // removes by moving the last rectangle into its place
+    void swap_remove(std::size_t index) noexcept {
+        --count;
+        xs[index] = xs[count];
+        ys[index] = ys[count];
+        ws[index] = ws[count];
+        hs[index] = hs[count];
+        xs[count] = ys[count] = ws[count] = hs[count] = 0;
+    }
+
+    void set(std::size_t index, const SDL_Rect& r) noexcept {
+        xs[index] = r.x;
+        ys[index] = r.y;
+        ws[index] = r.w;
+        hs[index] = r.h;
+    }
+
+    rect operator[](std::size_t index) const noexcept {
+        return { xs[index], ys[index], ws[index], hs[index] };
+    }
+
+    void clear() noexcept {
+        xs.clear();
+        ys.clear();
+        ws.clear();
+        hs.clear();
+        count = 0;
+    }
+
+    std::size_t size() const noexcept {
+        return count;
+    }
+
+    bool empty() const noexcept {
+        return count == 0;
+    }
+
+    // direct access to the arrays, writing past size() breaks the padding
+    int* x() noexcept {
+        return xs.data();
+    }
+
+    const int* x() const noexcept {
+        return xs.data();
+    }
+
+    int* y() noexcept {
+        return ys.data();
+    }
+
+    const int* y() const noexcept {
+        return ys.data();
+    }
+
+    int* w() noexcept {
+        return ws.data();
+    }
+
+    const int* w() const noexcept {
+        return ws.data();
+    }
+
+    int* h() noexcept {
+        return hs.data();
+    }
+
+    const int* h() const noexcept {
+        return hs.data();
+    }
+
+    // sets bit i of the mask when rectangle i intersects the area, same as rect::intersects
+    void intersects(const SDL_Rect& area, std::vector<uint64_t>& mask) const {
+        prepare(mask, count);
+        if(area.w <= 0 || area.h <= 0) {
+            return;
+        }
+
+        switch(detail::simd()) {
+#if defined(GUM_HAS_X86_SIMD)
+        case detail::simd_level::avx2:
+            intersects_avx2(area, mask.data());
+            break;
+        case detail::simd_level::sse41:
+            intersects_sse41(area, mask.data());
+            break;
+#endif // GUM_HAS_X86_SIMD
+        default:
+            intersects_scalar(area, mask.data());
+            break;
+        }
+    }
+
+    void intersecting(const SDL_Rect& area, std::vector<uint32_t>& indices, std::vector<uint64_t>& scratch) const {
+        intersects(area, scratch);
+        indices.clear();
+        detail::for_each_bit(scratch.data(), scratch.size(), [&indices](std::size_t i) {
+            indices.push_back(static_cast<uint32_t>(i));
+        });
+    }
+
+    // sets bit i of the mask when rectangle i contains the point
+    void contains(int x, int y, std::vector<uint64_t>& mask) const {
+        prepare(mask, count);
+        switch(detail::simd()) {
+#if defined(GUM_HAS_X86_SIMD)
+        case detail::simd_level::avx2:
+            contains_avx2(x, y, mask.data());
+            break;
+        case detail::simd_level::sse41:
+            contains_sse41(x, y, mask.data());
+            break;
+#endif // GUM_HAS_X86_SIMD
+        default:
+            contains_scalar(x, y, mask.data());
+            break;
+        }
+    }
+
+    void containing(int x, int y, std::vector<uint32_t>& indices, std::vector<uint64_t>& scratch) const {
+        contains(x, y, scratch);
+        indices.clear();
+        detail::for_each_bit(scratch.data(), scratch.size(), [&indices](std::size_t i) {
+            indices.push_back(static_cast<uint32_t>(i));
+        });
+    }
+
+    bool contains_any(int x, int y) const noexcept {
+        switch(detail::simd()) {
+#if defined(GUM_HAS_X86_SIMD)
+        case detail::simd_level::avx2:
+            return contains_any_avx2(x, y);
+        case detail::simd_level::sse41:
+            return contains_any_sse41(x, y);
+#endif // GUM_HAS_X86_SIMD
+        default:
+            return contains_any_scalar(x, y);
+        }
+    }
+
+    // sets bit i of the mask when point i is inside any of the rectangles
+    void contains_any(const SDL_Point* points, std::size_t n, std::vector<uint64_t>& mask) const {
+        prepare(mask, n);
+        for(std::size_t i = 0; i < n; ++i) {
+            if(contains_any(points[i].x, points[i].y)) {
+                mask[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+    }
+
+    // the union of every non-empty rectangle, same as folding with rect::union_with
+    rect bounds() const noexcept {
+        switch(detail::simd()) {
+#if defined(GUM_HAS_X86_SIMD)
+        case detail::simd_level::avx2:
+            return bounds_avx2();
+        case detail::simd_level::sse41:
+            return bounds_sse41();
+#endif // GUM_HAS_X86_SIMD
+        default:
+            return bounds_scalar();
+        }
+    }
+};
+} // sdl
+
+#endif // GUM_SPATIAL_RECT_ARRAY_HPP
@@ -0,0 +1,299 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_SPATIAL_SPATIAL_HASH_HPP
+#define GUM_SPATIAL_SPATIAL_HASH_HPP
+
+#include <gum/detail/aabb.hpp>
+#include <gum/video/rect.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sdl {
+// a uniform grid of cells stored sparsely in a hash map, suited to
+// objects of similar sizes spread over an unbounded world
+struct spatial_hash {
+private:
+    struct entry {
+        rect area;
+        int x1 = 0;  // the range of cells covered, inclusive
+        int y1 = 0;
+        int x2 = -1;
+        int y2 = -1;
+        bool alive = false;
+    };
+
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+    std::vector<entry> entries;  // indexed by id
+    mutable std::vector<uint32_t> stamps; // last query that visited the id, to report it only once
+    mutable uint32_t stamp = 0;
+    std::size_t count = 0;
+    int cell = 64;
+
+    static uint64_t key(int x, int y) noexcept {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    }
+
+    // rounds towards negative infinity unlike plain integer division
+    int cell_of(int coordinate) const noexcept {
+        return coordinate >= 0 ? coordinate / cell : -((cell - 1 - coordinate) / cell);
+    }
+
+    void cover(entry& e) const noexcept {
+        e.x1 = cell_of(e.area.x);
+        e.y1 = cell_of(e.area.y);
+        e.x2 = cell_of(e.area.x + (e.area.w > 0 ? e.area.w - 1 : 0));
+        e.y2 = cell_of(e.area.y + (e.area.h > 0 ? e.area.h - 1 : 0));
+    }
+
+    void link(uint32_t id, const entry& e) {
+        for(int y = e.y1; y <= e.y2; ++y) {
+            for(int x = e.x1; x <= e.x2; ++x) {
+                cells[key(x, y)].push_back(id);
+            }
+        }
+    }
+
+    void unlink(uint32_t id, const entry& e) {
+        for(int y = e.y1; y <= e.y2; ++y) {
+            for(int x = e.x1; x <= e.x2; ++x) {
+                auto it = cells.find(key(x, y));
+                if(it == cells.end()) {
+                    continue;
+                }
+
+                auto&& ids = it->second;
+                for(std::size_t i = 0; i < ids.size(); ++i) {
+                    if(ids[i] == id) {
+                        ids[i] = ids.back();
+                        ids.pop_back();
+                        break;
+                    }
+                }
+
+                // objects wandering around would otherwise leave empty cells behind forever
+                if(ids.empty()) {
+                    cells.erase(it);
+                }
+            }
+        }
+    }
+
+    uint32_t next_stamp() const {
+        if(++stamp == 0) {
+            // wrapped around so old stamps could match again
+            std::fill(stamps.begin(), stamps.end(), 0u);
+            stamp = 1;
+        }
+        stamps.resize(entries.size());
+        return stamp;
+    }
+public:
+    explicit spatial_hash(int cell_size = 64) noexcept: cell(cell_size > 0 ? cell_size : 1) {}
+
+    int cell_size() const noexcept {
+        return cell;
+    }
+
+    // ids index the storage directly so they should be small and dense, e.g. an index into an array
+    void insert(uint32_t id, const rect& area) {
+        if(id >= entries.size()) {
+            entries.resize(id + 1);
+        }
+
+        auto&& e = entries[id];
+        if(e.alive) {
+            move(id, area);
+            return;
+        }
+
+        e.area = area;
+        e.alive = true;
+        cover(e);
+        link(id, e);
+        ++count;
+    }
+
+    // only touches the cells when the object crossed a cell boundary
+    void move(uint32_t id, const rect& area) {
+        if(id >= entries.size() || !entries[id].alive) {
+            insert(id, area);
+            return;
+        }
+
+        auto&& e = entries[id];
+        entry updated = e;
+        updated.area = area;
+        cover(updated);
+        if(updated.x1 != e.x1 || updated.y1 != e.y1 || updated.x2 != e.x2 || updated.y2 != e.y2) {
+            unlink(id, e);
+            link(id, updated);
+        }
+        e = updated;
+    }
+
+    void erase(uint32_t id) {
+        if(id < entries.size() && entries[id].alive) {
+            unlink(id, entries[id]);
+            entries[id].alive = false;
+            --count;
+        }
+    }
+
+    // keeps the cells around so refilling doesn't allocate, see shrink
+    void clear() noexcept {
+        for(auto&& c : cells) {
+            c.second.clear();
+        }
+
+        for(auto&& e : entries) {
+            e.alive = false;
+        }
+        count = 0;
+    }
+
+    // frees the cells left empty, e.g. by clear
+    void shrink() {
+        for(auto it = cells.begin(); it != cells.end();) {
+            if(it->second.empty()) {
+                it = cells.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    bool contains(uint32_t id) const noexcept {
+        return id < entries.size() && entries[id].alive;
+    }
+
+    rect bounds(uint32_t id) const noexcept {
+        return contains(id) ? entries[id].area : rect();
+    }
+
+    std::size_t size() const noexcept {
+        return count;
+    }
+
+    bool empty() const noexcept {
+        return count == 0;
+    }
+
+    // calls f(id) once for every object overlapping the area. The ids already seen are
+    // tracked in mutable members, so concurrent queries race even though they're const
+    template<typename Function>
+    void query(const rect& area, Function f) const {
+        if(area.w <= 0 || area.h <= 0) {
+            return;
+        }
+
+        auto current = next_stamp();
+        auto x1 = cell_of(area.x);
+        auto y1 = cell_of(area.y);
+        auto x2 = cell_of(area.x + area.w - 1);
+        auto y2 = cell_of(area.y + area.h - 1);
+        for(int y = y1; y <= y2; ++y) {
+            for(int x = x1; x <= x2; ++x) {
+                auto it = cells.find(key(x, y));
+                if(it == cells.end()) {
+                    continue;
+                }
+
+                for(auto&& id : it->second) {
+                    if(stamps[id] != current) {
+                        stamps[id] = current;
+                        if(detail::overlaps(entries[id].area, area)) {
+                            f(id);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void query(const rect& area, std::vector<uint32_t>& result) const {
+        result.clear();
+        query(area, [&result](uint32_t id) { result.push_back(id); });
+    }
+
+    // calls f(id) for every object containing the point, e.g. for mouse picking
+    template<typename Function>
+    void pick(int x, int y, Function f) const {
+        auto it = cells.find(key(cell_of(x), cell_of(y)));
+        if(it == cells.end()) {
+            return;
+        }
+
+        for(auto&& id : it->second) {
+            if(detail::contains(entries[id].area, x, y)) {
+                f(id);
+            }
+        }
+    }
+
+    void pick(int x, int y, std::vector<uint32_t>& result) const {
+        result.clear();
+        pick(x, y, [&result](uint32_t id) { result.push_back(id); });
+    }
+
+    // calls f(a, b) once for every pair of overlapping objects with a < b
+    template<typename Function>
+    void pairs(Function f) const {
+        for(auto&& c : cells) {
+            auto&& ids = c.second;
+            auto cx = static_cast<int>(static_cast<uint32_t>(c.first >> 32));
+            auto cy = static_cast<int>(static_cast<uint32_t>(c.first));
+            for(std::size_t i = 0; i < ids.size(); ++i) {
+                auto&& a = entries[ids[i]].area;
+                for(std::size_t j = i + 1; j < ids.size(); ++j) {
+                    auto&& b = entries[ids[j]].area;
+                    if(!detail::overlaps(a, b)) {
+                        continue;
+                    }
+
+                    // pairs sharing several cells are only reported by the
+                    // cell holding the top left corner of their intersection
+                    if(cell_of(a.x > b.x ? a.x : b.x) != cx || cell_of(a.y > b.y ? a.y : b.y) != cy) {
+                        continue;
+                    }
+
+                    if(ids[i] < ids[j]) {
+                        f(ids[i], ids[j]);
+                    }
+                    else {
+                        f(ids[j], ids[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    void pairs(std::vector<std::pair<uint32_t, uint32_t>>& result) const {
+        result.clear();
+        pairs([&result](uint32_t a, uint32_t b) { result.emplace_back(a, b); });
+    }
+};
+} // sdl
+
+#endif // GUM_SPATIAL_SPATIAL_HASH_HPP
@@ -23,14 +23,35 @@
 #include <gum/video/colour.hpp>
 #include <gum/video/rect.hpp>
 #include <gum/video/vector.hpp>
+#include <gum/video/vector_array.hpp>
+#include <gum/video/fixed.hpp>
 #include <gum/video/window.hpp>
+#include <gum/video/render_state.hpp>
+#include <gum/video/command_buffer.hpp>
+#include <gum/video/command_recorders.hpp>
+#include <gum/video/draw_list.hpp>
+#include <gum/video/dirty_region.hpp>
+#include <gum/video/view.hpp>
 #include <gum/video/display_mode.hpp>
 #include <gum/video/rectangle.hpp>
+#include <gum/video/rectangle_batch.hpp>
 #include <gum/video/point.hpp>
 #include <gum/video/line.hpp>
+#include <gum/video/point_batch.hpp>
+#include <gum/video/polyline.hpp>
 #include <gum/video/texture.hpp>
+#include <gum/video/streaming_texture.hpp>
+#include <gum/video/texture_cache.hpp>
+#include <gum/video/async_loader.hpp>
 #include <gum/video/surface.hpp>
 #include <gum/video/sprite.hpp>
+#include <gum/video/sprite_storage.hpp>
+#include <gum/video/atlas.hpp>
 #include <gum/video/message_box.hpp>
 
+#if defined(GUM_HAS_RENDER_GEOMETRY)
+#include <gum/video/sprite_batch.hpp>
+#include <gum/video/shape.hpp>
+#endif
+
 #endif // GUM_VIDEO_HPP
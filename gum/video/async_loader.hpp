@@ -0,0 +1,322 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_VIDEO_ASYNC_LOADER_HPP
+#define GUM_VIDEO_ASYNC_LOADER_HPP
+
+#include <gum/core/config.hpp>
+#include <gum/detail/mpmc_queue.hpp>
+#include <gum/platform/thread_pool.hpp>
+#include <gum/video/surface.hpp>
+#include <gum/video/texture.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sdl {
+enum class load_status : int {
+    pending,   // waiting for a worker
+    decoding,  // being decoded by a worker
+    decoded,   // waiting for upload
+    ready,     // the texture can be used
+    failed,
+    cancelled
+};
+
+namespace detail {
+struct load_request {
+    std::string filename;
+    int priority = 0;
+    uint64_t order = 0;  // keeps requests of the same priority first come first served
+    std::atomic<int> status;
+    surface image{ static_cast<SDL_Surface*>(nullptr) };
+    texture result;
+    std::string error;
+
+    load_request(std::string filename, int priority, uint64_t order):
+        filename(std::move(filename)), priority(priority), order(order), status(static_cast<int>(load_status::pending)) {}
+
+    bool advance(load_status from, load_status to) noexcept {
+        auto expected = static_cast<int>(from);
+        return status.compare_exchange_strong(expected, static_cast<int>(to), std::memory_order_acq_rel);
+    }
+};
+
+// the top of the heap is the request with the highest priority
+struct load_order {
+    bool operator()(const std::shared_ptr<load_request>& lhs, const std::shared_ptr<load_request>& rhs) const noexcept {
+        return lhs->priority != rhs->priority ? lhs->priority < rhs->priority : lhs->order > rhs->order;
+    }
+};
+} // detail
+
+// refers to an image being loaded by an async_loader, copies refer to the same image
+struct load_handle {
+private:
+    friend struct async_loader;
+    std::shared_ptr<detail::load_request> state;
+
+    explicit load_handle(std::shared_ptr<detail::load_request> state) noexcept: state(std::move(state)) {}
+public:
+    load_handle() = default;
+
+    bool valid() const noexcept {
+        return state != nullptr;
+    }
+
+    load_status status() const noexcept {
+        return static_cast<load_status>(state->status.load(std::memory_order_acquire));
+    }
+
+    bool ready() const noexcept {
+        return status() == load_status::ready;
+    }
+
+    bool done() const noexcept {
+        auto s = status();
+        return s == load_status::ready || s == load_status::failed || s == load_status::cancelled;
+    }
+
+    // returns false if it's too late to cancel, i.e. the texture was already uploaded or failed
+    bool cancel() noexcept {
+        return state->advance(load_status::pending, load_status::cancelled) ||
+               state->advance(load_status::decoding, load_status::cancelled) ||
+               state->advance(load_status::decoded, load_status::cancelled);
+    }
+
+    int priority() const noexcept {
+        return state->priority;
+    }
+
+    const std::string& filename() const noexcept {
+        return state->filename;
+    }
+
+    // only meaningful once ready
+    const sdl::texture& texture() const noexcept {
+        return state->result;
+    }
+
+    // the reason decoding failed
+    const std::string& error() const noexcept {
+        return state->error;
+    }
+};
+
+// decodes images on the workers of a thread pool and uploads them as textures on
+// the thread calling upload, which has to be the thread that owns the renderer.
+// Decoded images are handed over through a lock free queue so workers never wait
+// on the render thread, and upload can be limited so a frame only spends so long on it
+struct async_loader {
+private:
+    using request_ptr = std::shared_ptr<detail::load_request>;
+
+    thread_pool& pool;
+    std::vector<request_ptr> queued;  // heap of the requests waiting for a worker
+    std::mutex mutex;
+    std::condition_variable idle;
+    std::size_t running = 0;          // tasks submitted to the pool that haven't finished
+    uint64_t counter = 0;
+    detail::mpmc_queue<request_ptr> decoded;
+    std::vector<request_ptr> overflow; // decoded images that didn't fit in the queue, guarded by mutex
+    std::atomic<bool> overflowed;
+    std::atomic<std::size_t> unfinished;
+
+    // every task takes whichever request has the highest priority when it starts
+    void decode_next() {
+        request_ptr request;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(!queued.empty()) {
+                std::pop_heap(queued.begin(), queued.end(), detail::load_order());
+                request = std::move(queued.back());
+                queued.pop_back();
+            }
+        }
+
+        if(request != nullptr) {
+            decode(request);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if(--running == 0) {
+            idle.notify_all();
+        }
+    }
+
+    void decode(request_ptr& request) {
+        if(!request->advance(load_status::pending, load_status::decoding)) {
+            --unfinished;
+            return;
+        }
+
+#ifndef GUM_IMG_DISABLED
+        auto* image = IMG_Load(request->filename.c_str());
+#else
+        auto* image = SDL_LoadBMP(request->filename.c_str());
+#endif
+        if(image == nullptr) {
+            // the error handler isn't used since this isn't the thread that asked for the image
+            request->error = SDL_GetError();
+            SDL_ClearError();
+            request->advance(load_status::decoding, load_status::failed);
+            --unfinished;
+            return;
+        }
+
+        request->image = surface(image);
+        if(!request->advance(load_status::decoding, load_status::decoded)) {
+            request->image = surface(static_cast<SDL_Surface*>(nullptr));
+            --unfinished;
+            return;
+        }
+
+        // workers never wait for the render thread, they are shared with other users of the pool
+        if(!decoded.try_push(request)) {
+            std::lock_guard<std::mutex> lock(mutex);
+            overflow.push_back(std::move(request));
+            overflowed.store(true, std::memory_order_release);
+        }
+    }
+
+    bool next_decoded(request_ptr& request) {
+        if(decoded.try_pop(request)) {
+            return true;
+        }
+
+        if(!overflowed.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if(overflow.empty()) {
+            return false;
+        }
+
+        // oldest first, the list is only used when uploads fall far behind
+        request = std::move(overflow.front());
+        overflow.erase(overflow.begin());
+        overflowed.store(!overflow.empty(), std::memory_order_release);
+        return true;
+    }
+public:
+    // queue_size is how many decoded images can wait for upload in the lock free queue,
+    // any more wait in a list guarded by a mutex
+    explicit async_loader(thread_pool& pool, std::size_t queue_size = 256):
+        pool(pool), decoded(queue_size), overflowed(false), unfinished(0) {}
+
+    async_loader(const async_loader&) = delete;
+    async_loader& operator=(const async_loader&) = delete;
+
+    // cancels everything that isn't done and waits for the workers to let go of the loader
+    ~async_loader() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for(auto&& request : queued) {
+            request->advance(load_status::pending, load_status::cancelled);
+        }
+        queued.clear();
+        idle.wait(lock, [this] { return running == 0; });
+
+        request_ptr request;
+        while(decoded.try_pop(request)) {
+            request->advance(load_status::decoded, load_status::cancelled);
+        }
+
+        for(auto&& waiting : overflow) {
+            waiting->advance(load_status::decoded, load_status::cancelled);
+        }
+        overflow.clear();
+    }
+
+    // higher priorities are decoded first
+    load_handle load(std::string filename, int priority = 0) {
+        request_ptr request;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            request = std::make_shared<detail::load_request>(std::move(filename), priority, counter++);
+            queued.push_back(request);
+            // counted before the request can be seen by a worker, which may finish it right away
+            ++unfinished;
+            std::push_heap(queued.begin(), queued.end(), detail::load_order());
+            ++running;
+        }
+
+        pool.submit([this] { decode_next(); });
+        return load_handle(std::move(request));
+    }
+
+    // uploads decoded images as textures until limit textures were uploaded, nothing is left
+    // or the time budget ran out. At least one image is uploaded if any are waiting
+    template<typename Window, typename Rep, typename Period>
+    std::size_t upload(const Window& win, std::size_t limit, const std::chrono::duration<Rep, Period>& budget) {
+        auto start = std::chrono::steady_clock::now();
+        std::size_t uploaded = 0;
+        request_ptr request;
+        while(uploaded < limit && next_decoded(request)) {
+            --unfinished;
+            if(request->status.load(std::memory_order_acquire) != static_cast<int>(load_status::decoded)) {
+                request->image = surface(static_cast<SDL_Surface*>(nullptr));
+                continue;
+            }
+
+            // SDL is called directly since the error handler could throw with the request already taken
+            static_assert(detail::is_valid_renderer<Window>::value, "Type must either be an sdl::window or SDL_Renderer*");
+            sdl::texture result(SDL_CreateTextureFromSurface(detail::renderer_trait::get(win), request->image.data()));
+            request->image = surface(static_cast<SDL_Surface*>(nullptr));
+            if(!result) {
+                request->error = SDL_GetError();
+                SDL_ClearError();
+                request->advance(load_status::decoded, load_status::failed);
+                continue;
+            }
+
+            // a cancel racing with the upload wins, the texture is then dropped
+            request->result = std::move(result);
+            if(!request->advance(load_status::decoded, load_status::ready)) {
+                request->result = sdl::texture();
+            }
+
+            ++uploaded;
+            if(std::chrono::steady_clock::now() - start >= budget) {
+                break;
+            }
+        }
+        return uploaded;
+    }
+
+    template<typename Window>
+    std::size_t upload(const Window& win, std::size_t limit = SIZE_MAX) {
+        return upload(win, limit, std::chrono::steady_clock::duration::max());
+    }
+
+    // the number of requests that are not done yet
+    std::size_t pending() const noexcept {
+        return unfinished.load();
+    }
+};
+} // sdl
+
+#endif // GUM_VIDEO_ASYNC_LOADER_HPP
@@ -0,0 +1,432 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_VIDEO_ATLAS_HPP
+#define GUM_VIDEO_ATLAS_HPP
+
+#include <gum/core/error.hpp>
+#include <gum/video/rect.hpp>
+#include <gum/video/surface.hpp>
+#include <gum/video/texture.hpp>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sdl {
+struct skyline_packer {
+private:
+    struct node {
+        int x;
+        int y;
+        int width;
+    };
+
+    std::vector<node> skyline;
+    std::vector<rect> free_list;  // areas given back through release
+    int width_ = 0;
+    int height_ = 0;
+
+    // returns the y coordinate a rectangle placed at the node would be at or -1 if it doesn't fit
+    int fit(std::size_t index, int w, int h) const noexcept {
+        auto x = skyline[index].x;
+        if(x + w > width_) {
+            return -1;
+        }
+
+        int y = skyline[index].y;
+        int remaining = w;
+        for(auto i = index; remaining > 0; ++i) {
+            if(i == skyline.size()) {
+                return -1;
+            }
+
+            y = std::max(y, skyline[i].y);
+            if(y + h > height_) {
+                return -1;
+            }
+            remaining -= skyline[i].width;
+        }
+        return y;
+    }
+
+    void place(std::size_t index, const rect& area) {
+        node added = { area.x, area.y + area.h, area.w };
+        skyline.insert(skyline.begin() + index, added);
+
+        // shrink or remove the nodes that are now covered by the new one
+        for(auto i = index + 1; i < skyline.size(); ) {
+            auto&& previous = skyline[i - 1];
+            auto&& current = skyline[i];
+            auto end = previous.x + previous.width;
+            if(current.x >= end) {
+                break;
+            }
+
+            auto shrink = end - current.x;
+            current.x += shrink;
+            current.width -= shrink;
+            if(current.width > 0) {
+                break;
+            }
+            skyline.erase(skyline.begin() + i);
+        }
+
+        // merge nodes of the same height
+        for(std::size_t i = 0; i + 1 < skyline.size(); ) {
+            if(skyline[i].y == skyline[i + 1].y) {
+                skyline[i].width += skyline[i + 1].width;
+                skyline.erase(skyline.begin() + i + 1);
+            }
+            else {
+                ++i;
+            }
+        }
+    }
+
+    bool take_free(int w, int h, rect& result) {
+        // best area fit amongst the released areas
+        auto best = free_list.end();
+        for(auto it = free_list.begin(); it != free_list.end(); ++it) {
+            if(it->w >= w && it->h >= h && (best == free_list.end() || it->w * it->h < best->w * best->h)) {
+                best = it;
+            }
+        }
+
+        if(best == free_list.end()) {
+            return false;
+        }
+
+        auto area = *best;
+        free_list.erase(best);
+        result = rect(area.x, area.y, w, h);
+
+        // split the remainder along the shorter leftover axis
+        rect right(area.x + w, area.y, area.w - w, h);
+        rect below(area.x, area.y + h, area.w, area.h - h);
+        if(area.w - w > area.h - h) {
+            right.h = area.h;
+            below.w = w;
+        }
+
+        if(!right.empty()) {
+            free_list.push_back(right);
+        }
+
+        if(!below.empty()) {
+            free_list.push_back(below);
+        }
+        return true;
+    }
+public:
+    skyline_packer() = default;
+    skyline_packer(int width, int height) {
+        reset(width, height);
+    }
+
+    void reset(int width, int height) {
+        width_ = width;
+        height_ = height;
+        skyline.assign(1, node{ 0, 0, width });
+        free_list.clear();
+    }
+
+    int width() const noexcept {
+        return width_;
+    }
+
+    int height() const noexcept {
+        return height_;
+    }
+
+    // whether insert would succeed, without changing anything
+    bool fits(int w, int h) const noexcept {
+        if(w <= 0 || h <= 0) {
+            return false;
+        }
+
+        for(auto&& area : free_list) {
+            if(area.w >= w && area.h >= h) {
+                return true;
+            }
+        }
+
+        for(std::size_t i = 0; i < skyline.size(); ++i) {
+            if(fit(i, w, h) >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool insert(int w, int h, rect& result) {
+        if(w <= 0 || h <= 0) {
+            return false;
+        }
+
+        if(take_free(w, h, result)) {
+            return true;
+        }
+
+        // bottom-left heuristic, ties are broken by the narrowest node
+        auto best = skyline.size();
+        int best_y = height_;
+        int best_width = width_ + 1;
+        for(std::size_t i = 0; i < skyline.size(); ++i) {
+            auto y = fit(i, w, h);
+            if(y >= 0 && (y < best_y || (y == best_y && skyline[i].width < best_width))) {
+                best = i;
+                best_y = y;
+                best_width = skyline[i].width;
+            }
+        }
+
+        if(best == skyline.size()) {
+            return false;
+        }
+
+        result = rect(skyline[best].x, best_y, w, h);
+        place(best, result);
+        return true;
+    }
+
+    void release(const rect& area) {
+        if(!area.empty()) {
+            free_list.push_back(area);
+        }
+    }
+};
+
+struct atlas_region {
+    const sdl::texture* texture = nullptr; // non owning, refers to a page of the atlas
+    rect area;
+};
+
+struct atlas {
+private:
+    struct page {
+        sdl::texture tex;
+        skyline_packer packer;
+    };
+
+    std::vector<std::unique_ptr<page>> pages; // unique_ptr to keep texture addresses stable
+    std::unordered_map<std::string, atlas_region> table;
+    SDL_Renderer* render = nullptr;
+    int page_width = 0;
+    int page_height = 0;
+    int padding = 0;
+
+    // the page is only added once an image was uploaded into it, so a failure leaves no empty page behind
+    std::unique_ptr<page> make_page() {
+        std::unique_ptr<page> result(new page());
+        result->tex.create(page_width, page_height, render);
+        if(!result->tex) {
+            SDL_SetError("could not create an atlas page");
+            return nullptr;
+        }
+
+        result->packer.reset(page_width, page_height);
+        SDL_SetTextureBlendMode(result->tex.data(), SDL_BLENDMODE_BLEND);
+
+        // static textures start off with undefined contents so clear it in bands
+        const int band = 64;
+        std::vector<uint32_t> zeroes(static_cast<std::size_t>(page_width) * band, 0);
+        for(int y = 0; y < page_height; y += band) {
+            rect area(0, y, page_width, std::min(band, page_height - y));
+            SDL_UpdateTexture(result->tex.data(), &area, zeroes.data(), page_width * 4);
+        }
+        return result;
+    }
+
+    bool upload(const std::string& name, SDL_Surface* image) {
+        if(image == nullptr) {
+            SDL_SetError("image '%s' is null", name.c_str());
+            return false;
+        }
+
+        auto w = image->w + padding;
+        auto h = image->h + padding;
+        if(w > page_width || h > page_height) {
+            SDL_SetError("image '%s' does not fit in an atlas page", name.c_str());
+            return false;
+        }
+
+        std::unique_ptr<SDL_Surface, detail::surface_deleter> converted(SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_RGBA8888, 0));
+        if(converted == nullptr) {
+            return false;
+        }
+
+        page* destination = nullptr;
+        for(auto&& p : pages) {
+            if(p->packer.fits(w, h)) {
+                destination = p.get();
+                break;
+            }
+        }
+
+        // only the chosen page's packer is saved, so the area can be given back if the upload fails
+        rect area;
+        skyline_packer saved;
+        std::unique_ptr<page> added;
+        if(destination != nullptr) {
+            saved = destination->packer;
+            destination->packer.insert(w, h, area);
+        }
+        else {
+            added = make_page();
+            if(added == nullptr || !added->packer.insert(w, h, area)) {
+                return false;
+            }
+            destination = added.get();
+        }
+
+        area.w = image->w;
+        area.h = image->h;
+        if(SDL_UpdateTexture(destination->tex.data(), &area, converted->pixels, converted->pitch) != 0) {
+            if(added == nullptr) {
+                destination->packer = saved;
+            }
+            return false;
+        }
+
+        if(added != nullptr) {
+            pages.push_back(std::move(added));
+        }
+
+        erase(name);
+        atlas_region& region = table[name];
+        region.texture = &destination->tex;
+        region.area = area;
+        return true;
+    }
+public:
+    template<typename Window>
+    atlas(const Window& win, int page_size = 2048, int padding = 1): render(detail::renderer_trait::get(win)), padding(padding) {
+        static_assert(detail::is_valid_renderer<Window>::value, "Type must either be an sdl::window or SDL_Renderer*");
+        SDL_RendererInfo info;
+        page_width = page_height = page_size;
+        if(SDL_GetRendererInfo(render, &info) == 0) {
+            if(info.max_texture_width > 0) {
+                page_width = std::min(page_width, info.max_texture_width);
+            }
+
+            if(info.max_texture_height > 0) {
+                page_height = std::min(page_height, info.max_texture_height);
+            }
+        }
+    }
+
+    bool insert(const std::string& name, const surface& image) {
+        if(!upload(name, image.data())) {
+            GUM_ERROR_HANDLER(false);
+        }
+        return true;
+    }
+
+    bool insert_file(const std::string& name, const std::string& filename) {
+        surface image(filename);
+        return image && insert(name, image);
+    }
+
+    template<typename InputIt>
+    bool insert(InputIt first, InputIt last) {
+        // packing is a lot tighter when the tallest images are placed first
+        std::vector<std::pair<const std::string*, SDL_Surface*>> images;
+        bool result = true;
+        for(; first != last; ++first) {
+            if(first->second.data() == nullptr) {
+                SDL_SetError("image '%s' is null", first->first.c_str());
+                GUM_ERROR_HANDLER_NO_RET();
+                result = false;
+                continue;
+            }
+            images.emplace_back(&first->first, first->second.data());
+        }
+
+        std::stable_sort(images.begin(), images.end(), [](const std::pair<const std::string*, SDL_Surface*>& lhs,
+                                                           const std::pair<const std::string*, SDL_Surface*>& rhs) {
+            return lhs.second->h != rhs.second->h ? lhs.second->h > rhs.second->h : lhs.second->w > rhs.second->w;
+        });
+
+        for(auto&& image : images) {
+            if(!upload(*image.first, image.second)) {
+                GUM_ERROR_HANDLER_NO_RET();
+                result = false;
+            }
+        }
+        return result;
+    }
+
+    bool insert_files(const std::vector<std::string>& filenames) {
+        std::vector<std::pair<std::string, surface>> images;
+        images.reserve(filenames.size());
+        for(auto&& filename : filenames) {
+            images.emplace_back(filename, surface(filename));
+            if(!images.back().second) {
+                return false;
+            }
+        }
+        return insert(images.begin(), images.end());
+    }
+
+    void erase(const std::string& name) {
+        auto it = table.find(name);
+        if(it == table.end()) {
+            return;
+        }
+
+        auto&& region = it->second;
+        for(auto&& p : pages) {
+            if(&p->tex == region.texture) {
+                auto area = region.area;
+                area.w += padding;
+                area.h += padding;
+                p->packer.release(area);
+                break;
+            }
+        }
+        table.erase(it);
+    }
+
+    const atlas_region* find(const std::string& name) const {
+        auto it = table.find(name);
+        return it == table.end() ? nullptr : &it->second;
+    }
+
+    const std::unordered_map<std::string, atlas_region>& regions() const noexcept {
+        return table;
+    }
+
+    std::size_t page_count() const noexcept {
+        return pages.size();
+    }
+
+    const sdl::texture& page_texture(std::size_t index) const noexcept {
+        return pages[index]->tex;
+    }
+
+    SDL_Point page_size() const noexcept {
+        return { page_width, page_height };
+    }
+};
+} // sdl
+
+#endif // GUM_VIDEO_ATLAS_HPP
@@ -75,6 +75,14 @@ struct colour : SDL_Color {
 
 };
 
+constexpr bool operator==(const SDL_Color& lhs, const SDL_Color& rhs) noexcept {
+    return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b && lhs.a == rhs.a;
+}
+
+constexpr bool operator!=(const SDL_Color& lhs, const SDL_Color& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
 using color = colour;
 } // sdl
 
@@ -0,0 +1,384 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_VIDEO_COMMAND_BUFFER_HPP
+#define GUM_VIDEO_COMMAND_BUFFER_HPP
+
+#include <gum/core/config.hpp>
+#include <gum/detail/radix_sort.hpp>
+#include <gum/detail/render_calls.hpp>
+#include <gum/video/colour.hpp>
+#include <gum/video/render_state.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace sdl {
+enum class command_type : uint8_t {
+    copy,
+    fill_rect,
+    draw_rect,
+    line,
+    point
+};
+
+namespace detail {
+// recorded instead of a blend mode when the renderer's current one should be kept
+constexpr uint8_t inherit_blend = 0xff;
+} // detail
+
+// kept as plain data so that recording is just a copy into contiguous memory
+struct render_command {
+    uint64_t key;
+    SDL_Texture* texture;
+    SDL_Rect source;
+    union {
+        SDL_Rect destination;    // for lines, x and y are the first point and w and h the second
+        detail::frect destinationf;  // for copies with a sub-pixel destination
+    };
+    SDL_Point center;
+    double angle;
+    SDL_Color colour;
+    command_type type;
+    uint8_t flip;
+    uint8_t blend;     // detail::inherit_blend keeps the blend mode of the renderer
+    uint8_t subpixel;  // whether destinationf is used
+    uint8_t depth_key; // whether the key has the depth order layout
+};
+
+static_assert(std::is_pod<render_command>::value, "render_command must be plain old data");
+
+struct command_buffer {
+private:
+    std::vector<render_command> commands;
+    std::vector<detail::sort_entry> order;
+    std::vector<detail::sort_entry> previous;  // the order of the last frame, used as a starting point
+    std::vector<detail::sort_entry> scratch;
+    std::vector<SDL_Rect> rects;    // used for coalescing runs of rectangles during replay
+    std::vector<SDL_Point> points;  // used for coalescing runs of points during replay
+    SDL_BlendMode blend_ = SDL_BLENDMODE_NONE;
+    bool inherit_blend_ = true;
+    bool depth_order_ = false;
+
+    static uint32_t material(const SDL_Texture* texture) noexcept {
+        // the low bits are dropped since they're the same due to alignment
+        return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(texture) >> 4);
+    }
+
+    static uint32_t material(const SDL_Color& c) noexcept {
+        return (static_cast<uint32_t>(c.r) << 24) | (static_cast<uint32_t>(c.g) << 16) |
+               (static_cast<uint32_t>(c.b) << 8) | static_cast<uint32_t>(c.a);
+    }
+
+    render_command& push(command_type type, uint8_t layer, uint32_t mat, uint8_t blend, uint16_t depth) {
+        commands.emplace_back(); // value initialised, so every member starts off zeroed
+        auto&& result = commands.back();
+        // commands of the same material are also grouped by type so that runs of
+        // primitives can be coalesced, the order doesn't matter for a single colour
+        auto kind = static_cast<uint64_t>(type);
+        if(depth_order_) {
+            result.key = make_depth_key(layer, depth, mat, blend) | (kind << 4);
+        }
+        else {
+            result.key = make_key(layer, mat, blend, depth) | (kind << 20);
+        }
+        result.type = type;
+        result.blend = blend;
+        result.depth_key = depth_order_;
+        return result;
+    }
+
+    // commands recorded into a buffer with the other depth order setting get their
+    // key rebuilt, both layouts hold the same fields so nothing is lost
+    void convert_key(render_command& cmd) const noexcept {
+        auto key = cmd.key;
+        auto layer = static_cast<uint8_t>(key >> 56);
+        uint32_t mat = 0;
+        uint64_t kind = 0;
+        uint8_t blend = 0;
+        uint16_t depth = 0;
+        if(cmd.depth_key) {
+            depth = static_cast<uint16_t>(key >> 40);
+            mat = static_cast<uint32_t>(key >> 8);
+            kind = (key >> 4) & 0xf;
+            blend = static_cast<uint8_t>(key & 0xf);
+        }
+        else {
+            mat = static_cast<uint32_t>(key >> 24);
+            kind = (key >> 20) & 0xf;
+            blend = static_cast<uint8_t>((key >> 16) & 0xf);
+            depth = static_cast<uint16_t>(key);
+        }
+
+        if(depth_order_) {
+            cmd.key = make_depth_key(layer, depth, mat, blend) | (kind << 4);
+        }
+        else {
+            cmd.key = make_key(layer, mat, blend, depth) | (kind << 20);
+        }
+        cmd.depth_key = depth_order_;
+    }
+
+    void primitive(command_type type, const SDL_Rect& area, const SDL_Color& c, uint8_t layer, uint16_t depth) {
+        auto mode = inherit_blend_ ? detail::inherit_blend : static_cast<uint8_t>(blend_);
+        auto&& cmd = push(type, layer, material(c), mode, depth);
+        cmd.destination = area;
+        cmd.colour = c;
+    }
+
+    // finds the end of the run of commands that can be drawn with a single call
+    std::size_t run_end(std::size_t first) const noexcept {
+        auto&& head = commands[order[first].index];
+        auto last = first + 1;
+        for(; last < order.size(); ++last) {
+            auto&& cmd = commands[order[last].index];
+            if(cmd.type != head.type || cmd.blend != head.blend || !(cmd.colour == head.colour)) {
+                break;
+            }
+        }
+        return last;
+    }
+public:
+    command_buffer() = default;
+
+    // layout: layer (8 bits) | material (32 bits) | type (4 bits) | blend (4 bits) | depth (16 bits)
+    static uint64_t make_key(uint8_t layer, uint32_t material, uint8_t blend, uint16_t depth) noexcept {
+        return (static_cast<uint64_t>(layer) << 56) | (static_cast<uint64_t>(material) << 24) |
+               (static_cast<uint64_t>(blend & 0xf) << 16) | static_cast<uint64_t>(depth);
+    }
+
+    // layout: layer (8 bits) | depth (16 bits) | material (32 bits) | type (4 bits) | blend (4 bits)
+    static uint64_t make_depth_key(uint8_t layer, uint16_t depth, uint32_t material, uint8_t blend) noexcept {
+        return (static_cast<uint64_t>(layer) << 56) | (static_cast<uint64_t>(depth) << 40) |
+               (static_cast<uint64_t>(material) << 8) | static_cast<uint64_t>(blend & 0xf);
+    }
+
+    // whether commands within a layer are ordered by depth before material, which gives
+    // back to front drawing at the cost of fewer texture and colour changes being merged.
+    // Only affects the commands recorded afterwards
+    void depth_order(bool enabled) noexcept {
+        depth_order_ = enabled;
+    }
+
+    bool depth_order() const noexcept {
+        return depth_order_;
+    }
+
+    // blend mode used for the primitives recorded afterwards
+    void blend(sdl::blend_mode mode) noexcept {
+        blend_ = static_cast<SDL_BlendMode>(mode);
+        inherit_blend_ = false;
+    }
+
+    // primitives recorded afterwards use whatever blend mode the renderer has when executed
+    void inherit_blend() noexcept {
+        inherit_blend_ = true;
+    }
+
+    bool blend_inherited() const noexcept {
+        return inherit_blend_;
+    }
+
+    sdl::blend_mode blend() const noexcept {
+        return static_cast<sdl::blend_mode>(blend_);
+    }
+
+    void copy(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& destination, double angle = 0.0,
+              const SDL_Point& center = SDL_Point{ 0, 0 }, SDL_RendererFlip flip = SDL_FLIP_NONE,
+              uint8_t layer = 0, uint16_t depth = 0) {
+        // textures carry their own blend mode
+        auto&& cmd = push(command_type::copy, layer, material(texture), 0, depth);
+        cmd.texture = texture;
+        cmd.source = source;
+        cmd.destination = destination;
+        cmd.center = center;
+        cmd.angle = angle;
+        cmd.flip = static_cast<uint8_t>(flip);
+    }
+
+    void copy(SDL_Texture* texture, const SDL_Rect& source, const detail::frect& destination, double angle = 0.0,
+              const SDL_Point& center = SDL_Point{ 0, 0 }, SDL_RendererFlip flip = SDL_FLIP_NONE,
+              uint8_t layer = 0, uint16_t depth = 0) {
+        copy(texture, source, SDL_Rect{ 0, 0, 0, 0 }, angle, center, flip, layer, depth);
+        auto&& cmd = commands.back();
+        cmd.destinationf = destination;
+        cmd.subpixel = 1;
+    }
+
+    void fill_rect(const SDL_Rect& area, const SDL_Color& c, uint8_t layer = 0, uint16_t depth = 0) {
+        primitive(command_type::fill_rect, area, c, layer, depth);
+    }
+
+    void draw_rect(const SDL_Rect& area, const SDL_Color& c, uint8_t layer = 0, uint16_t depth = 0) {
+        primitive(command_type::draw_rect, area, c, layer, depth);
+    }
+
+    void line(int x1, int y1, int x2, int y2, const SDL_Color& c, uint8_t layer = 0, uint16_t depth = 0) {
+        primitive(command_type::line, SDL_Rect{ x1, y1, x2, y2 }, c, layer, depth);
+    }
+
+    void point(int x, int y, const SDL_Color& c, uint8_t layer = 0, uint16_t depth = 0) {
+        primitive(command_type::point, SDL_Rect{ x, y, 0, 0 }, c, layer, depth);
+    }
+
+    void append(const render_command* first, std::size_t count) {
+        auto start = commands.size();
+        commands.insert(commands.end(), first, first + count);
+        for(auto i = start; i < commands.size(); ++i) {
+            if(commands[i].depth_key != static_cast<uint8_t>(depth_order_)) {
+                convert_key(commands[i]);
+            }
+        }
+    }
+
+    void append(const command_buffer& other) {
+        append(other.commands.data(), other.commands.size());
+    }
+
+    std::size_t size() const noexcept {
+        return commands.size();
+    }
+
+    bool empty() const noexcept {
+        return commands.empty();
+    }
+
+    const render_command* data() const noexcept {
+        return commands.data();
+    }
+
+    // removes every command while keeping the memory around for the next frame
+    void clear() noexcept {
+        commands.clear();
+        previous.swap(order);
+        order.clear();
+    }
+
+    // ties are kept in the order the commands were recorded in
+    void sort() {
+        auto size = commands.size();
+        if(previous.size() == size && size != 0) {
+            // the same number of commands as the last frame usually means the same scene
+            // recorded in the same order, so the old order is a good guess to start from
+            order.swap(previous);
+            previous.clear();
+            for(auto&& entry : order) {
+                entry.key = commands[entry.index].key;
+            }
+            detail::coherent_sort(order, scratch);
+            return;
+        }
+
+        order.resize(size);
+        for(std::size_t i = 0; i < size; ++i) {
+            order[i].key = commands[i].key;
+            order[i].index = static_cast<uint32_t>(i);
+        }
+        detail::radix_sort(order, scratch);
+    }
+
+    // the command at the given position in the order of the last sort
+    const render_command& sorted(std::size_t i) const noexcept {
+        return commands[order[i].index];
+    }
+
+    // sorts and issues every command then clears the buffer
+    void replay(render_state& state) {
+        sort();
+        execute(state);
+        clear();
+    }
+
+    // issues the commands in the order of the last sort without clearing the buffer,
+    // which allows issuing them more than once e.g. with a different clip rect each time
+    // the blend mode of the renderer is restored afterwards if a command changed it
+    void execute(render_state& state) {
+        auto* render = state.renderer();
+        auto inherited = SDL_BLENDMODE_NONE;
+        bool changed = false;
+        for(std::size_t i = 0; i < order.size(); ) {
+            auto&& cmd = commands[order[i].index];
+            if(cmd.type == command_type::copy) {
+                auto flip = static_cast<SDL_RendererFlip>(cmd.flip);
+                if(cmd.subpixel) {
+                    detail::copy(render, cmd.texture, cmd.source, state.translate(cmd.destinationf), cmd.angle, cmd.center, flip);
+                }
+                else {
+                    detail::copy(render, cmd.texture, cmd.source, state.translate(cmd.destination), cmd.angle, cmd.center, flip);
+                }
+                ++i;
+                continue;
+            }
+
+            if(cmd.blend != detail::inherit_blend) {
+                if(!changed) {
+                    inherited = static_cast<SDL_BlendMode>(state.blend());
+                    changed = true;
+                }
+                state.blend(static_cast<SDL_BlendMode>(cmd.blend));
+            }
+            else if(changed) {
+                state.blend(inherited);
+            }
+            state.draw_colour(cmd.colour);
+            auto last = run_end(i);
+            switch(cmd.type) {
+            case command_type::fill_rect:
+            case command_type::draw_rect:
+                rects.clear();
+                for(auto j = i; j < last; ++j) {
+                    rects.push_back(state.translate(commands[order[j].index].destination));
+                }
+
+                if(cmd.type == command_type::fill_rect) {
+                    SDL_RenderFillRects(render, rects.data(), static_cast<int>(rects.size()));
+                }
+                else {
+                    SDL_RenderDrawRects(render, rects.data(), static_cast<int>(rects.size()));
+                }
+                break;
+            case command_type::point:
+                points.clear();
+                for(auto j = i; j < last; ++j) {
+                    auto&& area = commands[order[j].index].destination;
+                    points.push_back(state.translate(area.x, area.y));
+                }
+                SDL_RenderDrawPoints(render, points.data(), static_cast<int>(points.size()));
+                break;
+            default:
+                for(auto j = i; j < last; ++j) {
+                    auto&& area = commands[order[j].index].destination;
+                    auto first = state.translate(area.x, area.y);
+                    auto second = state.translate(area.w, area.h);
+                    SDL_RenderDrawLine(render, first.x, first.y, second.x, second.y);
+                }
+                break;
+            }
+            i = last;
+        }
+
+        if(changed) {
+            state.blend(inherited);
+        }
+    }
+};
+} // sdl
+
+#endif // GUM_VIDEO_COMMAND_BUFFER_HPP
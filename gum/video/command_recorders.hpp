@@ -0,0 +1,82 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_VIDEO_COMMAND_RECORDERS_HPP
+#define GUM_VIDEO_COMMAND_RECORDERS_HPP
+
+#include <gum/platform/cpu.hpp>
+#include <gum/platform/thread_pool.hpp>
+#include <gum/video/command_buffer.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace sdl {
+// a set of command buffers that can be recorded into from many threads at once
+// as long as every thread has its own buffer, which means no locking is needed
+struct command_recorders {
+private:
+    struct slot {
+        command_buffer buffer;
+        char padding[64]; // keeps neighbouring buffers off the same cache line
+    };
+
+    std::vector<std::unique_ptr<slot>> slots;
+public:
+    explicit command_recorders(std::size_t count = 0) {
+        if(count == 0) {
+            auto cores = logical_cpu_cores();
+            count = cores > 0 ? static_cast<std::size_t>(cores) : 1;
+        }
+
+        slots.reserve(count);
+        for(std::size_t i = 0; i < count; ++i) {
+            slots.emplace_back(new slot());
+        }
+    }
+
+    std::size_t size() const noexcept {
+        return slots.size();
+    }
+
+    command_buffer& operator[](std::size_t index) noexcept {
+        return slots[index]->buffer;
+    }
+
+    // calls f(buffer, first, last) over [0, count) split across the pool
+    // with a distinct buffer for every chunk
+    template<typename Function>
+    void record(thread_pool& pool, std::size_t count, Function f) {
+        pool.parallel_for(count, slots.size(), [this, &f](std::size_t first, std::size_t last, std::size_t chunk) {
+            f(slots[chunk]->buffer, first, last);
+        });
+    }
+
+    // appends every recorded command to the destination in recorder order and
+    // then clears the recorders, meant to be called from the rendering thread
+    void merge(command_buffer& destination) {
+        for(auto&& s : slots) {
+            destination.append(s->buffer);
+            s->buffer.clear();
+        }
+    }
+};
+} // sdl
+
+#endif // GUM_VIDEO_COMMAND_RECORDERS_HPP
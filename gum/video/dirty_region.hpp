@@ -0,0 +1,166 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_VIDEO_DIRTY_REGION_HPP
+#define GUM_VIDEO_DIRTY_REGION_HPP
+
+#include <gum/video/rect.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace sdl {
+// a set of non-overlapping rectangles that need to be redrawn
+struct dirty_region {
+private:
+    std::vector<rect> rects;
+    rect limits;
+    std::size_t max_rects = 8;
+
+    static long long area(const rect& r) noexcept {
+        return static_cast<long long>(r.w) * r.h;
+    }
+
+    static rect merged(const rect& a, const rect& b) noexcept {
+        auto x1 = a.x < b.x ? a.x : b.x;
+        auto y1 = a.y < b.y ? a.y : b.y;
+        auto x2 = a.x + a.w > b.x + b.w ? a.x + a.w : b.x + b.w;
+        auto y2 = a.y + a.h > b.y + b.h ? a.y + a.h : b.y + b.h;
+        return { x1, y1, x2 - x1, y2 - y1 };
+    }
+
+    rect clipped(const rect& r) const noexcept {
+        if(limits.empty()) {
+            return r;
+        }
+
+        auto x1 = r.x > limits.x ? r.x : limits.x;
+        auto y1 = r.y > limits.y ? r.y : limits.y;
+        auto x2 = r.x + r.w < limits.x + limits.w ? r.x + r.w : limits.x + limits.w;
+        auto y2 = r.y + r.h < limits.y + limits.h ? r.y + r.h : limits.y + limits.h;
+        return x2 > x1 && y2 > y1 ? rect(x1, y1, x2 - x1, y2 - y1) : rect();
+    }
+public:
+    dirty_region() = default;
+    explicit dirty_region(const rect& limits) noexcept: limits(limits) {}
+
+    // the area every added rectangle is clipped to, an empty area means no clipping
+    void bounds(const rect& area) noexcept {
+        limits = area;
+    }
+
+    rect bounds() const noexcept {
+        return limits;
+    }
+
+    // the number of rectangles kept before they get merged regardless of the area wasted
+    void max_size(std::size_t count) noexcept {
+        max_rects = count == 0 ? 1 : count;
+    }
+
+    std::size_t max_size() const noexcept {
+        return max_rects;
+    }
+
+    void add(const rect& r) {
+        auto current = clipped(r);
+        if(current.empty()) {
+            return;
+        }
+
+        // overlapping rectangles are always merged so that nothing is drawn twice, others are
+        // merged when their union doesn't cover more than the two apart. merging can make the
+        // result overlap others so this is repeated until nothing changes
+        for(std::size_t i = 0; i < rects.size(); ) {
+            auto combined = merged(rects[i], current);
+            if(rects[i].intersects(current) || area(combined) <= area(rects[i]) + area(current)) {
+                current = combined;
+                rects[i] = rects.back();
+                rects.pop_back();
+                i = 0;
+            }
+            else {
+                ++i;
+            }
+        }
+
+        if(rects.size() < max_rects) {
+            rects.push_back(current);
+            return;
+        }
+
+        // too many rectangles, so merge with the one that grows the least
+        std::size_t best = 0;
+        auto best_growth = area(merged(rects[0], current)) - area(rects[0]);
+        for(std::size_t i = 1; i < rects.size(); ++i) {
+            auto growth = area(merged(rects[i], current)) - area(rects[i]);
+            if(growth < best_growth) {
+                best = i;
+                best_growth = growth;
+            }
+        }
+
+        auto combined = merged(rects[best], current);
+        rects[best] = rects.back();
+        rects.pop_back();
+        add(combined);
+    }
+
+    void add_all() {
+        rects.clear();
+        if(!limits.empty()) {
+            rects.push_back(limits);
+        }
+    }
+
+    void clear() noexcept {
+        rects.clear();
+    }
+
+    bool empty() const noexcept {
+        return rects.empty();
+    }
+
+    std::size_t size() const noexcept {
+        return rects.size();
+    }
+
+    const rect* data() const noexcept {
+        return rects.data();
+    }
+
+    std::vector<rect>::const_iterator begin() const noexcept {
+        return rects.begin();
+    }
+
+    std::vector<rect>::const_iterator end() const noexcept {
+        return rects.end();
+    }
+
+    bool intersects(const rect& r) const noexcept {
+        for(auto&& dirty : rects) {
+            if(dirty.intersects(r)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+} // sdl
+
+#endif // GUM_VIDEO_DIRTY_REGION_HPP
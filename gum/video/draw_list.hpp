@@ -0,0 +1,235 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_VIDEO_DRAW_LIST_HPP
+#define GUM_VIDEO_DRAW_LIST_HPP
+
+#include <gum/detail/slot_map.hpp>
+#include <gum/detail/type_traits.hpp>
+#include <gum/video/render_state.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sdl {
+// refers to a drawable of type T in a draw_list, stays valid until it is erased
+template<typename T>
+struct draw_handle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    constexpr draw_handle() noexcept = default;
+    constexpr draw_handle(uint32_t index, uint32_t generation) noexcept: index(index), generation(generation) {}
+};
+
+template<typename T>
+constexpr bool operator==(const draw_handle<T>& lhs, const draw_handle<T>& rhs) noexcept {
+    return lhs.index == rhs.index && lhs.generation == rhs.generation;
+}
+
+template<typename T>
+constexpr bool operator!=(const draw_handle<T>& lhs, const draw_handle<T>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+// a scene made of drawables of different types without a common base class. Every
+// type is kept in its own contiguous array, and drawing goes through the types one
+// after the other so that every call is resolved at compile time
+template<typename... Ts>
+struct draw_list {
+private:
+    std::tuple<detail::slot_map<Ts>...> stores;
+
+    template<typename T>
+    detail::slot_map<T>& store() noexcept {
+        return std::get<detail::type_index<T, Ts...>::value>(stores);
+    }
+
+    template<typename T>
+    const detail::slot_map<T>& store() const noexcept {
+        return std::get<detail::type_index<T, Ts...>::value>(stores);
+    }
+
+    template<typename Function, std::size_t... Is>
+    void for_each_store(Function& f, detail::index_sequence<Is...>) {
+        int expand[] = { 0, (f(std::get<Is>(stores)), 0)... };
+        (void)expand;
+    }
+
+    template<typename Function, std::size_t... Is>
+    void for_each_store(Function& f, detail::index_sequence<Is...>) const {
+        int expand[] = { 0, (f(std::get<Is>(stores)), 0)... };
+        (void)expand;
+    }
+
+    template<typename Function>
+    struct each_item {
+        Function& f;
+
+        template<typename Store>
+        void operator()(Store& store) const {
+            for(auto&& item : store.items()) {
+                f(item);
+            }
+        }
+    };
+
+    struct drawer {
+        render_state& state;
+
+        template<typename Drawable>
+        void operator()(const Drawable& drawable) const {
+            draw(drawable, is_state_drawable<const Drawable>());
+        }
+
+        template<typename Drawable>
+        void draw(const Drawable& drawable, std::true_type) const {
+            drawable.draw(state);
+        }
+
+        template<typename Drawable>
+        void draw(const Drawable& drawable, std::false_type) const {
+            drawable.draw(state.renderer());
+            // the drawable could have changed anything
+            state.invalidate();
+        }
+    };
+
+    struct counter {
+        std::size_t& total;
+
+        template<typename Store>
+        void operator()(const Store& store) const {
+            total += store.items().size();
+        }
+    };
+
+    struct clearer {
+        template<typename Store>
+        void operator()(Store& store) const {
+            store.clear();
+        }
+    };
+public:
+    draw_list() = default;
+
+    template<typename T>
+    draw_handle<T> insert(T value) {
+        auto&& s = store<T>();
+        auto slot = s.emplace(std::move(value));
+        return { slot, s.generation(slot) };
+    }
+
+    template<typename T, typename... Args>
+    draw_handle<T> emplace(Args&&... args) {
+        auto&& s = store<T>();
+        auto slot = s.emplace(std::forward<Args>(args)...);
+        return { slot, s.generation(slot) };
+    }
+
+    template<typename T>
+    bool contains(draw_handle<T> h) const noexcept {
+        return store<T>().contains(h.index, h.generation);
+    }
+
+    // moves the last drawable of the same type into the place of the erased one
+    template<typename T>
+    void erase(draw_handle<T> h) {
+        if(contains(h)) {
+            store<T>().erase(h.index);
+        }
+    }
+
+    // the handle must be valid
+    template<typename T>
+    T& operator[](draw_handle<T> h) noexcept {
+        return store<T>()[h.index];
+    }
+
+    template<typename T>
+    const T& operator[](draw_handle<T> h) const noexcept {
+        return store<T>()[h.index];
+    }
+
+    // every drawable of one type, contiguous in drawing order
+    template<typename T>
+    T* data() noexcept {
+        return store<T>().items().data();
+    }
+
+    template<typename T>
+    const T* data() const noexcept {
+        return store<T>().items().data();
+    }
+
+    template<typename T>
+    std::size_t count() const noexcept {
+        return store<T>().items().size();
+    }
+
+    template<typename T>
+    void reserve(std::size_t n) {
+        store<T>().reserve(n);
+    }
+
+    std::size_t size() const noexcept {
+        std::size_t total = 0;
+        counter c{ total };
+        for_each_store(c, detail::make_index_sequence<sizeof...(Ts)>());
+        return total;
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    // every handle becomes invalid
+    void clear() noexcept {
+        clearer c;
+        for_each_store(c, detail::make_index_sequence<sizeof...(Ts)>());
+    }
+
+    // calls f with every drawable, type by type in the order of Ts...
+    // f has to accept every type, e.g. a function object with a templated operator()
+    template<typename Function>
+    void for_each(Function f) {
+        each_item<Function> each{ f };
+        for_each_store(each, detail::make_index_sequence<sizeof...(Ts)>());
+    }
+
+    template<typename Function>
+    void for_each(Function f) const {
+        each_item<Function> each{ f };
+        for_each_store(each, detail::make_index_sequence<sizeof...(Ts)>());
+    }
+
+    void draw(render_state& state) const {
+        for_each(drawer{ state });
+    }
+
+    void draw(SDL_Renderer* render) const {
+        render_state state(render);
+        draw(state);
+    }
+};
+} // sdl
+
+#endif // GUM_VIDEO_DRAW_LIST_HPP
@@ -0,0 +1,548 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_VIDEO_FIXED_HPP
+#define GUM_VIDEO_FIXED_HPP
+
+#include <gum/video/rect.hpp>
+#include <gum/video/vector.hpp>
+#include <cstdint>
+#include <type_traits>
+
+namespace sdl {
+namespace detail {
+// converts the result of unsigned arithmetic back without relying on
+// the implementation defined out of range conversion
+constexpr int32_t wrapped(uint32_t n) noexcept {
+    return n <= uint32_t(INT32_MAX) ? static_cast<int32_t>(n) : -static_cast<int32_t>(~n) - 1;
+}
+
+constexpr int32_t saturated(int64_t n) noexcept {
+    return n > INT32_MAX ? INT32_MAX : n < INT32_MIN ? INT32_MIN : static_cast<int32_t>(n);
+}
+
+// floor((lhs + rhs) / 65536) for two 32.32 products without overflowing the sum
+constexpr int64_t product_sum(int64_t lhs, int64_t rhs) noexcept {
+    return (lhs >> 16) + (rhs >> 16) + (((lhs & 0xffff) + (rhs & 0xffff)) >> 16);
+}
+
+constexpr int64_t product_difference(int64_t lhs, int64_t rhs) noexcept {
+    return (lhs >> 16) - (rhs >> 16) + (((lhs & 0xffff) - (rhs & 0xffff)) >> 16);
+}
+
+// a double already scaled by 65536 rounded to the nearest, saturating instead of
+// converting an out of range number, which is undefined behaviour. NaN becomes 0
+constexpr int32_t rounded(double scaled) noexcept {
+    return scaled != scaled ? 0 :
+           scaled >= 2147483647.5 ? INT32_MAX :
+           scaled <= -2147483648.5 ? INT32_MIN :
+           static_cast<int32_t>(scaled + (scaled < 0 ? -0.5 : 0.5));
+}
+
+// the raw product and quotient of two 16.16 numbers, wrapping around on overflow
+constexpr int32_t product(int32_t lhs, int32_t rhs) noexcept {
+    return wrapped(static_cast<uint32_t>((static_cast<int64_t>(lhs) * rhs) >> 16));
+}
+
+// dividing by zero saturates towards the sign of the dividend, 0 / 0 is 0
+constexpr int32_t quotient(int32_t lhs, int32_t rhs) noexcept {
+    return rhs != 0 ? wrapped(static_cast<uint32_t>(static_cast<int64_t>(lhs) * 65536 / rhs)) :
+           lhs > 0 ? INT32_MAX : lhs < 0 ? INT32_MIN : 0;
+}
+} // detail
+
+// a 16.16 fixed point number. Every operation is done with integers so the
+// results are the same on every compiler and platform, which floating point
+// doesn't guarantee. Right shifts of negative numbers are assumed to be
+// arithmetic, which every supported compiler does. The arithmetic wraps
+// around on overflow and is done in uint32_t or int64_t so that it never
+// hits signed overflow
+struct fixed {
+private:
+    int32_t value = 0;
+
+    struct raw_tag {};
+    constexpr fixed(int32_t raw, raw_tag) noexcept: value(raw) {}
+public:
+    static constexpr int32_t one = 65536;
+
+    constexpr fixed() noexcept = default;
+
+    // every integer type converts so that e.g. fixed(1L) isn't ambiguous between int and double
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    constexpr fixed(Integer integer) noexcept: value(detail::wrapped(static_cast<uint32_t>(integer) << 16)) {}
+
+    // rounded to the nearest, meant for writing constants. Numbers out of range saturate
+    constexpr fixed(double number) noexcept: value(detail::rounded(number * one)) {}
+
+    static constexpr fixed from_raw(int32_t raw) noexcept {
+        return { raw, raw_tag{} };
+    }
+
+    constexpr int32_t raw() const noexcept {
+        return value;
+    }
+
+    // rounded towards negative infinity
+    constexpr int floor() const noexcept {
+        return value >> 16;
+    }
+
+    constexpr int ceil() const noexcept {
+        return static_cast<int>((static_cast<int64_t>(value) + (one - 1)) >> 16);
+    }
+
+    // rounded to the nearest, with halves rounded up
+    constexpr int round() const noexcept {
+        return static_cast<int>((static_cast<int64_t>(value) + one / 2) >> 16);
+    }
+
+    constexpr float to_float() const noexcept {
+        return static_cast<float>(value) / one;
+    }
+
+    constexpr double to_double() const noexcept {
+        return static_cast<double>(value) / one;
+    }
+
+    fixed& operator+=(fixed rhs) noexcept {
+        value = detail::wrapped(static_cast<uint32_t>(value) + static_cast<uint32_t>(rhs.value));
+        return *this;
+    }
+
+    fixed& operator-=(fixed rhs) noexcept {
+        value = detail::wrapped(static_cast<uint32_t>(value) - static_cast<uint32_t>(rhs.value));
+        return *this;
+    }
+
+    fixed& operator*=(fixed rhs) noexcept {
+        value = detail::product(value, rhs.value);
+        return *this;
+    }
+
+    fixed& operator/=(fixed rhs) noexcept {
+        value = detail::quotient(value, rhs.value);
+        return *this;
+    }
+};
+
+constexpr fixed operator+(fixed lhs, fixed rhs) noexcept {
+    return fixed::from_raw(detail::wrapped(static_cast<uint32_t>(lhs.raw()) + static_cast<uint32_t>(rhs.raw())));
+}
+
+constexpr fixed operator-(fixed lhs, fixed rhs) noexcept {
+    return fixed::from_raw(detail::wrapped(static_cast<uint32_t>(lhs.raw()) - static_cast<uint32_t>(rhs.raw())));
+}
+
+constexpr fixed operator-(fixed unary) noexcept {
+    return fixed::from_raw(detail::wrapped(0u - static_cast<uint32_t>(unary.raw())));
+}
+
+// the product is rounded towards negative infinity
+constexpr fixed operator*(fixed lhs, fixed rhs) noexcept {
+    return fixed::from_raw(detail::product(lhs.raw(), rhs.raw()));
+}
+
+// the quotient is rounded towards zero
+constexpr fixed operator/(fixed lhs, fixed rhs) noexcept {
+    return fixed::from_raw(detail::quotient(lhs.raw(), rhs.raw()));
+}
+
+constexpr bool operator==(fixed lhs, fixed rhs) noexcept {
+    return lhs.raw() == rhs.raw();
+}
+
+constexpr bool operator!=(fixed lhs, fixed rhs) noexcept {
+    return lhs.raw() != rhs.raw();
+}
+
+constexpr bool operator<(fixed lhs, fixed rhs) noexcept {
+    return lhs.raw() < rhs.raw();
+}
+
+constexpr bool operator>(fixed lhs, fixed rhs) noexcept {
+    return rhs < lhs;
+}
+
+constexpr bool operator<=(fixed lhs, fixed rhs) noexcept {
+    return !(rhs < lhs);
+}
+
+constexpr bool operator>=(fixed lhs, fixed rhs) noexcept {
+    return !(lhs < rhs);
+}
+
+constexpr fixed abs(fixed f) noexcept {
+    return f.raw() < 0 ? -f : f;
+}
+
+namespace detail {
+// bit by bit integer square root, the result is rounded down
+inline uint32_t isqrt(uint64_t n) noexcept {
+    uint64_t result = 0;
+    uint64_t bit = uint64_t(1) << 62;
+    while(bit > n) {
+        bit >>= 2;
+    }
+
+    while(bit != 0) {
+        if(n >= result + bit) {
+            n -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return static_cast<uint32_t>(result);
+}
+
+// sin(x) for a quarter turn in 256 steps, in 16.16
+inline const int32_t* sine_table() noexcept {
+    static const int32_t table[257] = {
+        0, 402, 804, 1206, 1608, 2010, 2412, 2814,
+        3216, 3617, 4019, 4420, 4821, 5222, 5623, 6023,
+        6424, 6824, 7224, 7623, 8022, 8421, 8820, 9218,
+        9616, 10014, 10411, 10808, 11204, 11600, 11996, 12391,
+        12785, 13180, 13573, 13966, 14359, 14751, 15143, 15534,
+        15924, 16314, 16703, 17091, 17479, 17867, 18253, 18639,
+        19024, 19409, 19792, 20175, 20557, 20939, 21320, 21699,
+        22078, 22457, 22834, 23210, 23586, 23961, 24335, 24708,
+        25080, 25451, 25821, 26190, 26558, 26925, 27291, 27656,
+        28020, 28383, 28745, 29106, 29466, 29824, 30182, 30538,
+        30893, 31248, 31600, 31952, 32303, 32652, 33000, 33347,
+        33692, 34037, 34380, 34721, 35062, 35401, 35738, 36075,
+        36410, 36744, 37076, 37407, 37736, 38064, 38391, 38716,
+        39040, 39362, 39683, 40002, 40320, 40636, 40951, 41264,
+        41576, 41886, 42194, 42501, 42806, 43110, 43412, 43713,
+        44011, 44308, 44604, 44898, 45190, 45480, 45769, 46056,
+        46341, 46624, 46906, 47186, 47464, 47741, 48015, 48288,
+        48559, 48828, 49095, 49361, 49624, 49886, 50146, 50404,
+        50660, 50914, 51166, 51417, 51665, 51911, 52156, 52398,
+        52639, 52878, 53114, 53349, 53581, 53812, 54040, 54267,
+        54491, 54714, 54934, 55152, 55368, 55582, 55794, 56004,
+        56212, 56418, 56621, 56823, 57022, 57219, 57414, 57607,
+        57798, 57986, 58172, 58356, 58538, 58718, 58896, 59071,
+        59244, 59415, 59583, 59750, 59914, 60075, 60235, 60392,
+        60547, 60700, 60851, 60999, 61145, 61288, 61429, 61568,
+        61705, 61839, 61971, 62101, 62228, 62353, 62476, 62596,
+        62714, 62830, 62943, 63054, 63162, 63268, 63372, 63473,
+        63572, 63668, 63763, 63854, 63944, 64031, 64115, 64197,
+        64277, 64354, 64429, 64501, 64571, 64639, 64704, 64766,
+        64827, 64884, 64940, 64993, 65043, 65091, 65137, 65180,
+        65220, 65259, 65294, 65328, 65358, 65387, 65413, 65436,
+        65457, 65476, 65492, 65505, 65516, 65525, 65531, 65535,
+        65536
+    };
+    return table;
+}
+
+// atan(x) in degrees for x in [0, 1] in 256 steps, in 16.16
+inline const int32_t* arctangent_table() noexcept {
+    static const int32_t table[257] = {
+        0, 14668, 29335, 44001, 58666, 73329, 87990, 102648,
+        117304, 131955, 146603, 161246, 175884, 190517, 205144, 219765,
+        234379, 248986, 263585, 278177, 292760, 307334, 321899, 336454,
+        350999, 365534, 380058, 394570, 409070, 423558, 438034, 452496,
+        466945, 481380, 495801, 510207, 524598, 538973, 553333, 567676,
+        582003, 596312, 610605, 624879, 639135, 653372, 667591, 681790,
+        695970, 710129, 724268, 738387, 752484, 766560, 780613, 794645,
+        808654, 822641, 836604, 850544, 864460, 878352, 892219, 906062,
+        919879, 933671, 947438, 961178, 974893, 988580, 1002241, 1015875,
+        1029481, 1043060, 1056611, 1070133, 1083627, 1097092, 1110529, 1123936,
+        1137313, 1150661, 1163979, 1177267, 1190524, 1203751, 1216947, 1230111,
+        1243245, 1256347, 1269417, 1282455, 1295461, 1308435, 1321376, 1334285,
+        1347161, 1360004, 1372813, 1385590, 1398332, 1411041, 1423717, 1436358,
+        1448965, 1461538, 1474076, 1486580, 1499049, 1511483, 1523882, 1536246,
+        1548575, 1560868, 1573127, 1585349, 1597536, 1609687, 1621803, 1633882,
+        1645926, 1657933, 1669904, 1681839, 1693738, 1705600, 1717426, 1729215,
+        1740967, 1752683, 1764362, 1776004, 1787610, 1799179, 1810710, 1822205,
+        1833663, 1845084, 1856467, 1867814, 1879123, 1890396, 1901631, 1912829,
+        1923990, 1935113, 1946200, 1957249, 1968261, 1979236, 1990173, 2001074,
+        2011937, 2022763, 2033552, 2044303, 2055018, 2065695, 2076336, 2086939,
+        2097505, 2108034, 2118526, 2128981, 2139399, 2149780, 2160125, 2170432,
+        2180703, 2190937, 2201134, 2211295, 2221419, 2231507, 2241558, 2251572,
+        2261551, 2271492, 2281398, 2291267, 2301101, 2310898, 2320659, 2330384,
+        2340074, 2349727, 2359345, 2368927, 2378474, 2387985, 2397460, 2406901,
+        2416306, 2425675, 2435010, 2444310, 2453574, 2462804, 2471999, 2481159,
+        2490285, 2499376, 2508433, 2517455, 2526443, 2535397, 2544317, 2553203,
+        2562055, 2570873, 2579658, 2588409, 2597126, 2605811, 2614461, 2623079,
+        2631664, 2640215, 2648734, 2657220, 2665673, 2674093, 2682482, 2690837,
+        2699161, 2707452, 2715711, 2723939, 2732134, 2740298, 2748430, 2756531,
+        2764600, 2772638, 2780644, 2788620, 2796564, 2804478, 2812361, 2820213,
+        2828035, 2835826, 2843587, 2851318, 2859019, 2866690, 2874330, 2881941,
+        2889523, 2897075, 2904597, 2912090, 2919554, 2926989, 2934395, 2941772,
+        2949120
+    };
+    return table;
+}
+
+// a quarter turn is 16384, the table lookup is linearly interpolated
+inline int32_t quarter_sine(int32_t angle) noexcept {
+    auto* table = sine_table();
+    auto index = angle >> 6;
+    auto fraction = angle & 63;
+    if(index == 256) {
+        return table[256];
+    }
+    return table[index] + (((table[index + 1] - table[index]) * fraction) >> 6);
+}
+
+// converts degrees to a binary angle where a full turn is 65536
+inline int32_t binary_angle(fixed degrees) noexcept {
+    const int64_t turn = 360 * static_cast<int64_t>(fixed::one);
+    auto wrapped = degrees.raw() % turn;
+    wrapped += wrapped < 0 ? turn : 0;
+    return static_cast<int32_t>(wrapped / 360);
+}
+
+// sin of a binary angle in [0, 65536)
+inline int32_t binary_sine(int32_t angle) noexcept {
+    auto offset = angle & 16383;
+    switch(angle >> 14) {
+    case 0:
+        return quarter_sine(offset);
+    case 1:
+        return quarter_sine(16384 - offset);
+    case 2:
+        return -quarter_sine(offset);
+    default:
+        return -quarter_sine(16384 - offset);
+    }
+}
+} // detail
+
+inline fixed sqrt(fixed f) noexcept {
+    if(f.raw() <= 0) {
+        return fixed();
+    }
+    return fixed::from_raw(static_cast<int32_t>(detail::isqrt(static_cast<uint64_t>(f.raw()) << 16)));
+}
+
+// trigonometry through lookup tables, angles are in degrees like sprite::rotation
+inline fixed sin(fixed degrees) noexcept {
+    return fixed::from_raw(detail::binary_sine(detail::binary_angle(degrees)));
+}
+
+// a quarter turn ahead of sin, added after reducing the angle so it can't wrap around
+inline fixed cos(fixed degrees) noexcept {
+    return fixed::from_raw(detail::binary_sine((detail::binary_angle(degrees) + 16384) & 65535));
+}
+
+// the angle of (x, y) in degrees in the range [-180, 180]
+inline fixed atan2(fixed y, fixed x) noexcept {
+    int64_t ax = x.raw() < 0 ? -static_cast<int64_t>(x.raw()) : x.raw();
+    int64_t ay = y.raw() < 0 ? -static_cast<int64_t>(y.raw()) : y.raw();
+    if(ax == 0 && ay == 0) {
+        return fixed();
+    }
+
+    // reduce to the first octant where the ratio is in [0, 1]
+    bool steep = ay > ax;
+    auto ratio = steep ? (ax << 16) / ay : (ay << 16) / ax;
+    auto* table = detail::arctangent_table();
+    auto index = ratio >> 8;
+    auto fraction = ratio & 255;
+    int64_t result = table[index];
+    if(index < 256) {
+        result += ((table[index + 1] - table[index]) * fraction) >> 8;
+    }
+
+    const int64_t right = 90 * static_cast<int64_t>(fixed::one);
+    result = steep ? right - result : result;
+    result = x.raw() < 0 ? 2 * right - result : result;
+    result = y.raw() < 0 ? -result : result;
+    return fixed::from_raw(static_cast<int32_t>(result));
+}
+
+// a vector of fixed point numbers, see sdl::fixed
+struct vector_fx {
+    fixed x;
+    fixed y;
+
+    constexpr vector_fx() noexcept = default;
+    constexpr vector_fx(fixed x, fixed y) noexcept: x(x), y(y) {}
+    constexpr explicit vector_fx(const SDL_Point& p) noexcept: x(p.x), y(p.y) {}
+
+    // computed at full precision like length, saturating past the largest fixed point number
+    constexpr fixed length_squared() const noexcept {
+        return fixed::from_raw(detail::saturated(detail::product_sum(static_cast<int64_t>(x.raw()) * x.raw(),
+                                                                     static_cast<int64_t>(y.raw()) * y.raw())));
+    }
+
+    fixed length() const noexcept {
+        // computed at full precision so that the square doesn't lose the fraction,
+        // lengths past the largest fixed point number saturate
+        auto xx = static_cast<int64_t>(x.raw()) * x.raw();
+        auto yy = static_cast<int64_t>(y.raw()) * y.raw();
+        auto result = detail::isqrt(static_cast<uint64_t>(xx) + static_cast<uint64_t>(yy));
+        return fixed::from_raw(result > INT32_MAX ? INT32_MAX : static_cast<int32_t>(result));
+    }
+
+    vector_fx normalised() const noexcept {
+        auto len = length();
+        if(len == 0) {
+            return *this;
+        }
+        return { x / len, y / len };
+    }
+
+    void normalise() noexcept {
+        *this = normalised();
+    }
+
+    // rotated clockwise on screen like sprite::rotation
+    vector_fx rotated(fixed degrees) const noexcept {
+        auto sine = sin(degrees);
+        auto cosine = cos(degrees);
+        return { x * cosine - y * sine, x * sine + y * cosine };
+    }
+
+    // rounded towards negative infinity, matching the pixel the vector is in
+    constexpr vector to_vector() const noexcept {
+        return { x.floor(), y.floor() };
+    }
+
+    constexpr vectorf to_vectorf() const noexcept {
+        return { x.to_float(), y.to_float() };
+    }
+
+    vector_fx& operator+=(const vector_fx& rhs) noexcept {
+        x += rhs.x;
+        y += rhs.y;
+        return *this;
+    }
+
+    vector_fx& operator-=(const vector_fx& rhs) noexcept {
+        x -= rhs.x;
+        y -= rhs.y;
+        return *this;
+    }
+
+    vector_fx& operator*=(fixed scalar) noexcept {
+        x *= scalar;
+        y *= scalar;
+        return *this;
+    }
+
+    vector_fx& operator/=(fixed scalar) noexcept {
+        x /= scalar;
+        y /= scalar;
+        return *this;
+    }
+};
+
+constexpr vector_fx operator+(const vector_fx& lhs, const vector_fx& rhs) noexcept {
+    return { lhs.x + rhs.x, lhs.y + rhs.y };
+}
+
+constexpr vector_fx operator-(const vector_fx& lhs, const vector_fx& rhs) noexcept {
+    return { lhs.x - rhs.x, lhs.y - rhs.y };
+}
+
+constexpr vector_fx operator*(const vector_fx& lhs, fixed scalar) noexcept {
+    return { lhs.x * scalar, lhs.y * scalar };
+}
+
+constexpr vector_fx operator*(fixed scalar, const vector_fx& rhs) noexcept {
+    return { rhs.x * scalar, rhs.y * scalar };
+}
+
+constexpr vector_fx operator/(const vector_fx& lhs, fixed scalar) noexcept {
+    return { lhs.x / scalar, lhs.y / scalar };
+}
+
+constexpr vector_fx operator-(const vector_fx& unary) noexcept {
+    return { -unary.x, -unary.y };
+}
+
+constexpr bool operator==(const vector_fx& lhs, const vector_fx& rhs) noexcept {
+    return lhs.x == rhs.x && lhs.y == rhs.y;
+}
+
+constexpr bool operator!=(const vector_fx& lhs, const vector_fx& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+// both are computed at full precision and saturate like vector_fx::length_squared
+constexpr fixed dot(const vector_fx& lhs, const vector_fx& rhs) noexcept {
+    return fixed::from_raw(detail::saturated(detail::product_sum(static_cast<int64_t>(lhs.x.raw()) * rhs.x.raw(),
+                                                                 static_cast<int64_t>(lhs.y.raw()) * rhs.y.raw())));
+}
+
+constexpr fixed determinant(const vector_fx& lhs, const vector_fx& rhs) noexcept {
+    return fixed::from_raw(detail::saturated(detail::product_difference(static_cast<int64_t>(lhs.x.raw()) * rhs.y.raw(),
+                                                                        static_cast<int64_t>(rhs.x.raw()) * lhs.y.raw())));
+}
+
+inline fixed distance(const vector_fx& from, const vector_fx& to) noexcept {
+    return (to - from).length();
+}
+
+inline fixed direction(const vector_fx& from, const vector_fx& to) noexcept {
+    return atan2(to.y - from.y, to.x - from.x);
+}
+
+// a rectangle of fixed point numbers with the same edge rules as rect
+struct rect_fx {
+    fixed x;
+    fixed y;
+    fixed w;
+    fixed h;
+
+    constexpr rect_fx() noexcept = default;
+    constexpr rect_fx(fixed x, fixed y, fixed w, fixed h) noexcept: x(x), y(y), w(w), h(h) {}
+    constexpr explicit rect_fx(const SDL_Rect& r) noexcept: x(r.x), y(r.y), w(r.w), h(r.h) {}
+
+    constexpr bool empty() const noexcept {
+        return w <= 0 || h <= 0;
+    }
+
+    constexpr bool intersects(const rect_fx& other) const noexcept {
+        return !empty() && !other.empty() &&
+               x < other.x + other.w && other.x < x + w &&
+               y < other.y + other.h && other.y < y + h;
+    }
+
+    constexpr bool contains(const vector_fx& p) const noexcept {
+        return p.x >= x && p.x < x + w && p.y >= y && p.y < y + h;
+    }
+
+    constexpr vector_fx position() const noexcept {
+        return { x, y };
+    }
+
+    // the smallest integer rectangle covering this one
+    constexpr rect bounds() const noexcept {
+        return empty() ? rect(x.floor(), y.floor(), 0, 0) :
+               rect(x.floor(), y.floor(), (x + w).ceil() - x.floor(), (y + h).ceil() - y.floor());
+    }
+};
+
+constexpr bool operator==(const rect_fx& lhs, const rect_fx& rhs) noexcept {
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.w == rhs.w && lhs.h == rhs.h;
+}
+
+constexpr bool operator!=(const rect_fx& lhs, const rect_fx& rhs) noexcept {
+    return !(lhs == rhs);
+}
+} // sdl
+
+#endif // GUM_VIDEO_FIXED_HPP
@@ -23,6 +23,10 @@
 #include <gum/core/config.hpp>
 #include <gum/video/vector.hpp>
 #include <gum/video/colour.hpp>
+#include <gum/video/rect.hpp>
+#include <gum/video/command_buffer.hpp>
+#include <gum/video/render_state.hpp>
+#include <utility>
 
 namespace sdl {
 struct line {
@@ -69,9 +73,28 @@ public:
         return c;
     }
 
-    void draw(SDL_Renderer* render) {
-        SDL_SetRenderDrawColor(render, c.r, c.g, c.b, c.a);
-        SDL_RenderDrawLine(render, one.x, one.y, two.x, two.y);
+    rect bounds() const noexcept {
+        auto x = one.x < two.x ? one.x : two.x;
+        auto y = one.y < two.y ? one.y : two.y;
+        auto w = one.x < two.x ? two.x - one.x : one.x - two.x;
+        auto h = one.y < two.y ? two.y - one.y : one.y - two.y;
+        return { x, y, w + 1, h + 1 };
+    }
+
+    void draw(render_state& state) const {
+        auto a = state.translate(one.x, one.y);
+        auto b = state.translate(two.x, two.y);
+        state.draw_colour(c);
+        SDL_RenderDrawLine(state.renderer(), a.x, a.y, b.x, b.y);
+    }
+
+    void draw(SDL_Renderer* render) const {
+        render_state state(render);
+        draw(state);
+    }
+
+    void record(command_buffer& buffer, uint8_t layer = 0, uint16_t depth = 0) const {
+        buffer.line(one.x, one.y, two.x, two.y, c, layer, depth);
     }
 };
 } // sdl
@@ -22,6 +22,10 @@
 
 #include <gum/core/config.hpp>
 #include <gum/video/colour.hpp>
+#include <gum/video/rect.hpp>
+#include <gum/video/command_buffer.hpp>
+#include <gum/video/render_state.hpp>
+#include <utility>
 
 namespace sdl {
 struct point : SDL_Point {
@@ -38,9 +42,23 @@ public:
         return c;
     }
 
-    void draw(SDL_Renderer* render) {
-        SDL_SetRenderDrawColor(render, c.r, c.g, c.b, c.a);
-        SDL_RenderDrawPoint(render, x, y);
+    rect bounds() const noexcept {
+        return { x, y, 1, 1 };
+    }
+
+    void draw(render_state& state) const {
+        auto p = state.translate(x, y);
+        state.draw_colour(c);
+        SDL_RenderDrawPoint(state.renderer(), p.x, p.y);
+    }
+
+    void draw(SDL_Renderer* render) const {
+        render_state state(render);
+        draw(state);
+    }
+
+    void record(command_buffer& buffer, uint8_t layer = 0, uint16_t depth = 0) const {
+        buffer.point(x, y, c, layer, depth);
     }
 };
 } // sdl
@@ -0,0 +1,138 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_VIDEO_POINT_BATCH_HPP
+#define GUM_VIDEO_POINT_BATCH_HPP
+
+#include <gum/core/config.hpp>
+#include <gum/detail/bounds.hpp>
+#include <gum/detail/colour_groups.hpp>
+#include <gum/video/colour.hpp>
+#include <gum/video/point.hpp>
+#include <gum/video/render_state.hpp>
+#include <gum/video/vector.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace sdl {
+struct point_batch {
+private:
+    detail::colour_groups<SDL_Point> groups;
+    std::size_t count = 0;
+    std::size_t threshold = 16;
+    detail::bounds_accumulator area;
+#if defined(GUM_HAS_RENDER_GEOMETRY)
+    mutable std::vector<SDL_Vertex> vertices;
+    mutable std::vector<int> indices;
+
+    void draw_geometry(SDL_Renderer* render, const vector& offset) const {
+        // every point becomes a 1x1 quad with the colour baked into the vertices
+        vertices.clear();
+        vertices.reserve(count * 4);
+        for(auto&& g : groups) {
+            for(auto&& p : g.items) {
+                float x = static_cast<float>(p.x + offset.x);
+                float y = static_cast<float>(p.y + offset.y);
+                vertices.push_back({ { x, y }, g.colour, { 0.0f, 0.0f } });
+                vertices.push_back({ { x + 1.0f, y }, g.colour, { 0.0f, 0.0f } });
+                vertices.push_back({ { x + 1.0f, y + 1.0f }, g.colour, { 0.0f, 0.0f } });
+                vertices.push_back({ { x, y + 1.0f }, g.colour, { 0.0f, 0.0f } });
+            }
+        }
+
+        for(auto i = static_cast<int>(indices.size() / 6), quads = static_cast<int>(count); i < quads; ++i) {
+            int base = i * 4;
+            int quad[] = { base, base + 1, base + 2, base + 2, base + 3, base };
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+
+        SDL_RenderGeometry(render, nullptr, vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(count * 6));
+    }
+#endif // GUM_HAS_RENDER_GEOMETRY
+public:
+    point_batch() = default;
+
+    void add(int x, int y, const colour& c = colour::white()) {
+        groups[c].push_back(SDL_Point{ x, y });
+        area.add(x, y, 1, 1);
+        ++count;
+    }
+
+    void add(const vector& pos, const colour& c = colour::white()) {
+        add(pos.x, pos.y, c);
+    }
+
+    void add(const point& p) {
+        add(p.x, p.y, p.fill());
+    }
+
+    void clear() noexcept {
+        groups.clear();
+        area.clear();
+        count = 0;
+    }
+
+    std::size_t size() const noexcept {
+        return count;
+    }
+
+    bool empty() const noexcept {
+        return count == 0;
+    }
+
+    std::size_t colours() const noexcept {
+        return groups.size();
+    }
+
+    rect bounds() const noexcept {
+        return area.result();
+    }
+
+    void geometry_threshold(std::size_t colours) noexcept {
+        threshold = colours;
+    }
+
+    std::size_t geometry_threshold() const noexcept {
+        return threshold;
+    }
+
+    void draw(render_state& state) const {
+#if defined(GUM_HAS_RENDER_GEOMETRY)
+        if(groups.size() > threshold) {
+            draw_geometry(state.renderer(), state.offset());
+            return;
+        }
+#endif // GUM_HAS_RENDER_GEOMETRY
+
+        for(auto&& g : groups) {
+            state.draw_colour(g.colour);
+            auto* points = state.translate(g.items.data(), g.items.size());
+            SDL_RenderDrawPoints(state.renderer(), points, static_cast<int>(g.items.size()));
+        }
+    }
+
+    void draw(SDL_Renderer* render) const {
+        render_state state(render);
+        draw(state);
+    }
+};
+} // sdl
+
+#endif // GUM_VIDEO_POINT_BATCH_HPP
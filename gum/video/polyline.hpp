@@ -0,0 +1,183 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_VIDEO_POLYLINE_HPP
+#define GUM_VIDEO_POLYLINE_HPP
+
+#include <gum/core/config.hpp>
+#include <gum/detail/bounds.hpp>
+#include <gum/detail/render_calls.hpp>
+#include <gum/video/colour.hpp>
+#include <gum/video/render_state.hpp>
+#include <gum/video/vector.hpp>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace sdl {
+struct polyline {
+private:
+    std::vector<detail::fpoint> points;
+    std::vector<SDL_Color> colours;   // one per point
+    colour c = colour::white();
+    bool uniform = true;              // whether every point has the colour `c`
+    detail::bounds_accumulator area;
+#if defined(GUM_HAS_RENDER_GEOMETRY)
+    mutable std::vector<SDL_Vertex> vertices;
+    mutable std::vector<int> indices;
+
+    void draw_geometry(SDL_Renderer* render, const vector& offset) const {
+        // every segment becomes a one pixel wide quad with the colours interpolated
+        // between both of its ends
+        vertices.clear();
+        indices.clear();
+        for(std::size_t i = 0; i + 1 < points.size(); ++i) {
+            float x1 = points[i].x + offset.x + 0.5f;
+            float y1 = points[i].y + offset.y + 0.5f;
+            float x2 = points[i + 1].x + offset.x + 0.5f;
+            float y2 = points[i + 1].y + offset.y + 0.5f;
+            float dx = x2 - x1;
+            float dy = y2 - y1;
+            float length = std::sqrt(dx * dx + dy * dy);
+            if(length == 0.0f) {
+                continue;
+            }
+
+            float nx = -dy / length * 0.5f;
+            float ny = dx / length * 0.5f;
+            int base = static_cast<int>(vertices.size());
+            vertices.push_back({ { x1 + nx, y1 + ny }, colours[i], { 0.0f, 0.0f } });
+            vertices.push_back({ { x2 + nx, y2 + ny }, colours[i + 1], { 0.0f, 0.0f } });
+            vertices.push_back({ { x2 - nx, y2 - ny }, colours[i + 1], { 0.0f, 0.0f } });
+            vertices.push_back({ { x1 - nx, y1 - ny }, colours[i], { 0.0f, 0.0f } });
+            int quad[] = { base, base + 1, base + 2, base + 2, base + 3, base };
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+
+        SDL_RenderGeometry(render, nullptr, vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(indices.size()));
+    }
+#endif // GUM_HAS_RENDER_GEOMETRY
+public:
+    polyline() = default;
+
+    void add(int x, int y) {
+        add(vectorf(static_cast<float>(x), static_cast<float>(y)));
+    }
+
+    void add(const vector& pos) {
+        add(pos.x, pos.y);
+    }
+
+    void add(const vectorf& pos) {
+        add(pos, c);
+    }
+
+    void add(int x, int y, const colour& point_colour) {
+        add(vectorf(static_cast<float>(x), static_cast<float>(y)), point_colour);
+    }
+
+    void add(const vector& pos, const colour& point_colour) {
+        add(pos.x, pos.y, point_colour);
+    }
+
+    void add(const vectorf& pos, const colour& point_colour) {
+        points.push_back(pos);
+        colours.push_back(point_colour);
+        area.add(static_cast<int>(std::floor(pos.x)), static_cast<int>(std::floor(pos.y)), 1, 1);
+        uniform = uniform && point_colour == c;
+    }
+
+    void clear() noexcept {
+        points.clear();
+        colours.clear();
+        area.clear();
+        uniform = true;
+    }
+
+    std::size_t size() const noexcept {
+        return points.size();
+    }
+
+    bool empty() const noexcept {
+        return points.empty();
+    }
+
+    void reserve(std::size_t count) {
+        points.reserve(count);
+        colours.reserve(count);
+    }
+
+    const detail::fpoint* data() const noexcept {
+        return points.data();
+    }
+
+    rect bounds() const noexcept {
+        return area.result();
+    }
+
+    void fill(colour fill_colour) {
+        c = fill_colour;
+        colours.assign(points.size(), c);
+        uniform = true;
+    }
+
+    colour fill() const noexcept {
+        return c;
+    }
+
+    void draw(render_state& state) const {
+#if defined(GUM_HAS_RENDER_GEOMETRY)
+        if(!uniform) {
+            draw_geometry(state.renderer(), state.offset());
+            return;
+        }
+#endif // GUM_HAS_RENDER_GEOMETRY
+
+        auto* translated = state.translate(points.data(), points.size());
+#if !defined(GUM_HAS_RENDER_GEOMETRY)
+        if(!uniform) {
+            // the colours can't be interpolated without geometry, so every segment takes
+            // the colour of the point it starts at and runs of one colour are drawn together
+            for(std::size_t first = 0; first + 1 < points.size(); ) {
+                auto last = first + 1;
+                while(last + 1 < points.size() && colours[last] == colours[first]) {
+                    ++last;
+                }
+
+                state.draw_colour(colours[first]);
+                detail::draw_lines(state.renderer(), translated + first, last - first + 1);
+                first = last;
+            }
+            return;
+        }
+#endif // GUM_HAS_RENDER_GEOMETRY
+
+        state.draw_colour(c);
+        detail::draw_lines(state.renderer(), translated, points.size());
+    }
+
+    void draw(SDL_Renderer* render) const {
+        render_state state(render);
+        draw(state);
+    }
+};
+} // sdl
+
+#endif // GUM_VIDEO_POLYLINE_HPP
@@ -21,27 +21,267 @@
 #define GUM_VIDEO_RECT_HPP
 
 #include <gum/core/config.hpp>
+#include <gum/detail/aabb.hpp>
+#include <gum/detail/float_types.hpp>
+#include <cmath>
+#include <cstddef>
 
 namespace sdl {
+// the operations match their SDL counterparts exactly but are implemented
+// inline so that they can be folded and inlined in tight loops
 struct rect : public SDL_Rect {
     constexpr rect() noexcept: SDL_Rect{0, 0, 0, 0} {}
     constexpr rect(int x, int y, int w, int h) noexcept: SDL_Rect{x, y, w, h} {}
 
-    bool intersects(const rect& other) const noexcept {
-        return SDL_HasIntersection(this, &other) != SDL_FALSE;
+    // same as SDL_HasIntersection
+    constexpr bool intersects(const rect& other) const noexcept {
+        return detail::overlaps(*this, other);
     }
 
-    bool empty() const noexcept {
-        return SDL_RectEmpty(this) != SDL_FALSE;
+    // same as SDL_RectEmpty
+    constexpr bool empty() const noexcept {
+        return w <= 0 || h <= 0;
     }
 
-    rect union_with(const rect& other) const noexcept {
-        rect result;
-        SDL_UnionRect(this, &other, &result);
+    // same as SDL_UnionRect
+    constexpr rect union_with(const rect& other) const noexcept {
+        return empty() ? (other.empty() ? rect() : other) :
+               other.empty() ? *this :
+               rect(detail::min(x, other.x), detail::min(y, other.y),
+                    detail::max(x + w, other.x + other.w) - detail::min(x, other.x),
+                    detail::max(y + h, other.y + other.h) - detail::min(y, other.y));
+    }
+
+    // same as SDL_IntersectRect, the result is empty when the rectangles don't
+    // intersect and like SDL it can have a negative size in that case
+    constexpr rect intersection(const rect& other) const noexcept {
+        return empty() || other.empty() ? rect() :
+               rect(detail::max(x, other.x), detail::max(y, other.y),
+                    detail::min(x + w, other.x + other.w) - detail::max(x, other.x),
+                    detail::min(y + h, other.y + other.h) - detail::max(y, other.y));
+    }
+
+    // same as SDL_PointInRect
+    constexpr bool contains(int px, int py) const noexcept {
+        return detail::contains(*this, px, py);
+    }
+
+    constexpr bool contains(const SDL_Point& p) const noexcept {
+        return contains(p.x, p.y);
+    }
+
+    // whether the other rectangle is entirely inside this one, empty
+    // rectangles are never contained
+    constexpr bool contains(const rect& other) const noexcept {
+        return !other.empty() && other.x >= x && other.y >= y &&
+               other.x + other.w <= x + w && other.y + other.h <= y + h;
+    }
+
+    // same as SDL_IntersectRectAndLine, clips the line to the rectangle and
+    // returns false when no part of it is inside
+    bool clip_line(int& x1, int& y1, int& x2, int& y2) const noexcept {
+        if(empty()) {
+            return false;
+        }
+
+        auto left = x;
+        auto top = y;
+        auto right = x + w - 1;
+        auto bottom = y + h - 1;
+
+        // entirely inside
+        if(x1 >= left && x1 <= right && x2 >= left && x2 <= right &&
+           y1 >= top && y1 <= bottom && y2 >= top && y2 <= bottom) {
+            return true;
+        }
+
+        // entirely to one side
+        if((x1 < left && x2 < left) || (x1 > right && x2 > right) ||
+           (y1 < top && y2 < top) || (y1 > bottom && y2 > bottom)) {
+            return false;
+        }
+
+        if(y1 == y2) {
+            x1 = x1 < left ? left : x1 > right ? right : x1;
+            x2 = x2 < left ? left : x2 > right ? right : x2;
+            return true;
+        }
+
+        if(x1 == x2) {
+            y1 = y1 < top ? top : y1 > bottom ? bottom : y1;
+            y2 = y2 < top ? top : y2 > bottom ? bottom : y2;
+            return true;
+        }
+
+        // Cohen-Sutherland, with the same integer rounding as SDL
+        int ax = x1, ay = y1, bx = x2, by = y2;
+        auto code1 = detail::out_code(*this, ax, ay);
+        auto code2 = detail::out_code(*this, bx, by);
+        while(code1 || code2) {
+            if(code1 & code2) {
+                return false;
+            }
+
+            auto code = code1 ? code1 : code2;
+            int px = 0, py = 0;
+            if(code & detail::code_top) {
+                py = top;
+                px = ax + ((bx - ax) * (py - ay)) / (by - ay);
+            }
+            else if(code & detail::code_bottom) {
+                py = bottom;
+                px = ax + ((bx - ax) * (py - ay)) / (by - ay);
+            }
+            else if(code & detail::code_left) {
+                px = left;
+                py = ay + ((by - ay) * (px - ax)) / (bx - ax);
+            }
+            else {
+                px = right;
+                py = ay + ((by - ay) * (px - ax)) / (bx - ax);
+            }
+
+            if(code1) {
+                ax = px;
+                ay = py;
+                code1 = detail::out_code(*this, px, py);
+            }
+            else {
+                bx = px;
+                by = py;
+                code2 = detail::out_code(*this, px, py);
+            }
+        }
+
+        x1 = ax;
+        y1 = ay;
+        x2 = bx;
+        y2 = by;
+        return true;
+    }
+
+    // batch versions of the above, the boolean results go into `result` and
+    // the number of true results is returned
+
+    std::size_t intersects(const SDL_Rect* rects, std::size_t count, bool* result) const noexcept {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i < count; ++i) {
+            result[i] = detail::overlaps(*this, rects[i]);
+            hits += result[i];
+        }
+        return hits;
+    }
+
+    // writes the intersection with every rectangle, returns how many are non-empty
+    std::size_t intersection(const SDL_Rect* rects, std::size_t count, SDL_Rect* result) const noexcept {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i < count; ++i) {
+            auto&& r = rects[i];
+            result[i] = intersection(rect(r.x, r.y, r.w, r.h));
+            hits += result[i].w > 0 && result[i].h > 0;
+        }
+        return hits;
+    }
+
+    std::size_t contains(const SDL_Point* points, std::size_t count, bool* result) const noexcept {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i < count; ++i) {
+            result[i] = contains(points[i].x, points[i].y);
+            hits += result[i];
+        }
+        return hits;
+    }
+
+    std::size_t contains(const SDL_Rect* rects, std::size_t count, bool* result) const noexcept {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i < count; ++i) {
+            auto&& r = rects[i];
+            result[i] = contains(rect(r.x, r.y, r.w, r.h));
+            hits += result[i];
+        }
+        return hits;
+    }
+
+    // every pair of points is a line that gets clipped in place
+    std::size_t clip_lines(SDL_Point* points, std::size_t lines, bool* result) const noexcept {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i < lines; ++i) {
+            auto&& a = points[2 * i];
+            auto&& b = points[2 * i + 1];
+            result[i] = clip_line(a.x, a.y, b.x, b.y);
+            hits += result[i];
+        }
+        return hits;
+    }
+
+    rect union_with(const SDL_Rect* rects, std::size_t count) const noexcept {
+        rect result = *this;
+        for(std::size_t i = 0; i < count; ++i) {
+            auto&& r = rects[i];
+            result = result.union_with(rect(r.x, r.y, r.w, r.h));
+        }
         return result;
     }
 };
 
+// same as SDL_EnclosePoints, computes the smallest rectangle containing every
+// point that lies inside the clip rectangle. Returns false if there are none
+inline bool enclose(const SDL_Point* points, std::size_t count, const rect& clip, rect& result) noexcept {
+    if(clip.empty()) {
+        return false;
+    }
+
+    auto left = clip.x;
+    auto top = clip.y;
+    auto right = clip.x + clip.w - 1;
+    auto bottom = clip.y + clip.h - 1;
+    bool added = false;
+    int min_x = 0, min_y = 0, max_x = 0, max_y = 0;
+    for(std::size_t i = 0; i < count; ++i) {
+        auto px = points[i].x;
+        auto py = points[i].y;
+        if(px < left || px > right || py < top || py > bottom) {
+            continue;
+        }
+
+        if(!added) {
+            min_x = max_x = px;
+            min_y = max_y = py;
+            added = true;
+            continue;
+        }
+
+        min_x = px < min_x ? px : min_x;
+        max_x = px > max_x ? px : max_x;
+        min_y = py < min_y ? py : min_y;
+        max_y = py > max_y ? py : max_y;
+    }
+
+    if(added) {
+        result = rect(min_x, min_y, max_x - min_x + 1, max_y - min_y + 1);
+    }
+    return added;
+}
+
+// the unclipped version, returns false only when there are no points
+inline bool enclose(const SDL_Point* points, std::size_t count, rect& result) noexcept {
+    if(count == 0) {
+        return false;
+    }
+
+    int min_x = points[0].x, max_x = points[0].x;
+    int min_y = points[0].y, max_y = points[0].y;
+    for(std::size_t i = 1; i < count; ++i) {
+        min_x = points[i].x < min_x ? points[i].x : min_x;
+        max_x = points[i].x > max_x ? points[i].x : max_x;
+        min_y = points[i].y < min_y ? points[i].y : min_y;
+        max_y = points[i].y > max_y ? points[i].y : max_y;
+    }
+
+    result = rect(min_x, min_y, max_x - min_x + 1, max_y - min_y + 1);
+    return true;
+}
+
 constexpr bool operator==(const rect& lhs, const rect& rhs) {
     return lhs.x == rhs.x && lhs.y == rhs.y && lhs.w == rhs.w && lhs.h == rhs.h;
 }
@@ -68,6 +308,72 @@ constexpr bool operator<=(const rect& lhs, const rect& rhs) {
 constexpr bool operator>=(const rect& lhs, const rect& rhs) {
     return !(lhs < rhs);
 }
+// a rectangle with floating point coordinates for sub-pixel positions,
+// layout compatible with SDL_FRect. Edges follow the same rules as rect,
+// the right and bottom edges are excluded and empty rectangles never intersect
+struct rectf : public detail::frect {
+    constexpr rectf() noexcept: detail::frect{0.0f, 0.0f, 0.0f, 0.0f} {}
+    constexpr rectf(float x, float y, float w, float h) noexcept: detail::frect{x, y, w, h} {}
+    constexpr explicit rectf(const SDL_Rect& r) noexcept:
+        detail::frect{static_cast<float>(r.x), static_cast<float>(r.y), static_cast<float>(r.w), static_cast<float>(r.h)} {}
+
+    constexpr bool empty() const noexcept {
+        return w <= 0.0f || h <= 0.0f;
+    }
+
+    constexpr bool intersects(const rectf& other) const noexcept {
+        return !empty() && !other.empty() &&
+               x < other.x + other.w && other.x < x + w &&
+               y < other.y + other.h && other.y < y + h;
+    }
+
+    constexpr bool contains(float px, float py) const noexcept {
+        return px >= x && px < x + w && py >= y && py < y + h;
+    }
+
+    rectf union_with(const rectf& other) const noexcept {
+        if(empty()) {
+            return other;
+        }
+
+        if(other.empty()) {
+            return *this;
+        }
+
+        auto left = x < other.x ? x : other.x;
+        auto top = y < other.y ? y : other.y;
+        auto right = x + w > other.x + other.w ? x + w : other.x + other.w;
+        auto bottom = y + h > other.y + other.h ? y + h : other.y + other.h;
+        return { left, top, right - left, bottom - top };
+    }
+
+    // the smallest integer rectangle covering this one
+    rect bounds() const noexcept {
+        auto left = static_cast<int>(std::floor(x));
+        auto top = static_cast<int>(std::floor(y));
+        if(empty()) {
+            return { left, top, 0, 0 };
+        }
+
+        auto right = static_cast<int>(std::ceil(x + w));
+        auto bottom = static_cast<int>(std::ceil(y + h));
+        return { left, top, right - left, bottom - top };
+    }
+
+    // rounded to the nearest integer, like vectorf::rounded
+    rect rounded() const noexcept {
+        return { static_cast<int>(std::lround(x)), static_cast<int>(std::lround(y)),
+                 static_cast<int>(std::lround(w)), static_cast<int>(std::lround(h)) };
+    }
+};
+
+constexpr bool operator==(const rectf& lhs, const rectf& rhs) {
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.w == rhs.w && lhs.h == rhs.h;
+}
+
+constexpr bool operator!=(const rectf& lhs, const rectf& rhs) {
+    return !(lhs == rhs);
+}
 } // sdl
 
 #endif // GUM_VIDEO_RECT_HPP
@@ -24,6 +24,9 @@
 #include <gum/video/rect.hpp>
 #include <gum/video/vector.hpp>
 #include <gum/video/colour.hpp>
+#include <gum/video/command_buffer.hpp>
+#include <gum/video/render_state.hpp>
+#include <utility>
 
 namespace sdl {
 struct rectangle {
@@ -87,14 +90,31 @@ public:
         return out_c;
     }
 
-    void draw(SDL_Renderer* render) {
+    rect bounds() const noexcept {
+        return out;
+    }
+
+    void draw(render_state& state) const {
+        auto outline_area = state.translate(out);
+        auto fill_area = state.translate(shape);
+
         // handle the outline first
-        SDL_SetRenderDrawColor(render, out_c.r, out_c.g, out_c.b, out_c.a);
-        SDL_RenderDrawRect(render, &out);
+        state.draw_colour(out_c);
+        SDL_RenderDrawRect(state.renderer(), &outline_area);
 
         // set the fill colour
-        SDL_SetRenderDrawColor(render, fill_c.r, fill_c.g, fill_c.b, fill_c.a);
-        SDL_RenderFillRect(render, &shape);
+        state.draw_colour(fill_c);
+        SDL_RenderFillRect(state.renderer(), &fill_area);
+    }
+
+    void draw(SDL_Renderer* render) const {
+        render_state state(render);
+        draw(state);
+    }
+
+    void record(command_buffer& buffer, uint8_t layer = 0, uint16_t depth = 0) const {
+        buffer.draw_rect(out, out_c, layer, depth);
+        buffer.fill_rect(shape, fill_c, layer, depth);
     }
 };
 } // sdl
@@ -0,0 +1,122 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_VIDEO_RECTANGLE_BATCH_HPP
+#define GUM_VIDEO_RECTANGLE_BATCH_HPP
+
+#include <gum/core/config.hpp>
+#include <gum/detail/bounds.hpp>
+#include <gum/detail/colour_groups.hpp>
+#include <gum/detail/render_calls.hpp>
+#include <gum/video/colour.hpp>
+#include <gum/video/rect.hpp>
+#include <gum/video/rectangle.hpp>
+#include <gum/video/render_state.hpp>
+#include <cstddef>
+
+namespace sdl {
+struct rectangle_batch {
+private:
+    detail::colour_groups<detail::frect> fills;
+    detail::colour_groups<detail::frect> outlines;
+    std::size_t count = 0;
+    detail::bounds_accumulator covered;
+
+    void push(detail::colour_groups<detail::frect>& groups, const rectf& area, const colour& c) {
+        if(!area.empty()) {
+            groups[c].push_back(area);
+            auto&& pixels = area.bounds();
+            covered.add(pixels.x, pixels.y, pixels.w, pixels.h);
+        }
+    }
+public:
+    rectangle_batch() = default;
+
+    void add(const rectangle& r) {
+        auto&& pos = r.position();
+        auto&& size = r.size();
+        push(outlines, rectf(rect(pos.x, pos.y, size.x, size.y)), r.outline());
+        push(fills, rectf(rect(pos.x + 1, pos.y + 1, size.x - 2, size.y - 2)), r.fill());
+        ++count;
+    }
+
+    void fill(const rect& area, const colour& c) {
+        fill(rectf(area), c);
+    }
+
+    void fill(const rectf& area, const colour& c) {
+        push(fills, area, c);
+        ++count;
+    }
+
+    void outline(const rect& area, const colour& c) {
+        outline(rectf(area), c);
+    }
+
+    void outline(const rectf& area, const colour& c) {
+        push(outlines, area, c);
+        ++count;
+    }
+
+    void clear() noexcept {
+        fills.clear();
+        outlines.clear();
+        covered.clear();
+        count = 0;
+    }
+
+    std::size_t size() const noexcept {
+        return count;
+    }
+
+    bool empty() const noexcept {
+        return count == 0;
+    }
+
+    std::size_t colours() const noexcept {
+        return fills.size() + outlines.size();
+    }
+
+    rect bounds() const noexcept {
+        return covered.result();
+    }
+
+    void draw(render_state& state) const {
+        // outlines go first to match the behaviour of sdl::rectangle
+        for(auto&& g : outlines) {
+            state.draw_colour(g.colour);
+            auto* rects = state.translate(g.items.data(), g.items.size());
+            detail::draw_rects(state.renderer(), rects, g.items.size());
+        }
+
+        for(auto&& g : fills) {
+            state.draw_colour(g.colour);
+            auto* rects = state.translate(g.items.data(), g.items.size());
+            detail::fill_rects(state.renderer(), rects, g.items.size());
+        }
+    }
+
+    void draw(SDL_Renderer* render) const {
+        render_state state(render);
+        draw(state);
+    }
+};
+} // sdl
+
+#endif // GUM_VIDEO_RECTANGLE_BATCH_HPP
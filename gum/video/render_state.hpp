@@ -0,0 +1,366 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_VIDEO_RENDER_STATE_HPP
+#define GUM_VIDEO_RENDER_STATE_HPP
+
+#include <gum/core/config.hpp>
+#include <gum/video/colour.hpp>
+#include <gum/video/rect.hpp>
+#include <gum/video/vector.hpp>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace sdl {
+enum class blend_mode : int {
+    none     = SDL_BLENDMODE_NONE,
+    blend    = SDL_BLENDMODE_BLEND,
+    add      = SDL_BLENDMODE_ADD,
+    modulate = SDL_BLENDMODE_MOD
+};
+
+struct render_stats {
+    std::size_t issued = 0;  // state changes forwarded to SDL
+    std::size_t skipped = 0; // state changes elided since the value was already set
+};
+
+// a shadow copy of the renderer state that elides redundant state changes
+struct render_state {
+private:
+    enum : unsigned {
+        known_colour   = 1 << 0,
+        known_blend    = 1 << 1,
+        known_target   = 1 << 2,
+        known_viewport = 1 << 3,
+        known_clip     = 1 << 4,
+        known_scale    = 1 << 5
+    };
+
+    SDL_Renderer* render = nullptr;
+    unsigned known = 0;
+    SDL_Color colour_ = { 0, 0, 0, 0 };
+    SDL_BlendMode blend_ = SDL_BLENDMODE_NONE;
+    SDL_Texture* target_ = nullptr;
+    rect viewport_;
+    rect clip_;
+    bool clipping = false;
+    float scale_x = 1.0f;
+    float scale_y = 1.0f;
+    vector offset_;
+    render_stats stats_;
+    std::vector<SDL_Point> moved_points;  // scratch memory for translating arrays
+    std::vector<SDL_Rect> moved_rects;
+#if defined(GUM_HAS_RENDER_FLOAT)
+    std::vector<SDL_FPoint> moved_fpoints;
+    std::vector<SDL_FRect> moved_frects;
+#endif // GUM_HAS_RENDER_FLOAT
+#if defined(GUM_HAS_RENDER_GEOMETRY)
+    std::vector<SDL_Vertex> moved_vertices;
+#endif // GUM_HAS_RENDER_GEOMETRY
+
+    void query_clip() noexcept {
+        if(!(known & known_clip)) {
+            SDL_RenderGetClipRect(render, &clip_);
+            clipping = SDL_RenderIsClipEnabled(render) == SDL_TRUE;
+            known |= known_clip;
+        }
+    }
+
+    bool needs(unsigned flag, bool same) noexcept {
+        if((known & flag) && same) {
+            ++stats_.skipped;
+            return false;
+        }
+        ++stats_.issued;
+        known |= flag;
+        return true;
+    }
+public:
+    render_state() noexcept = default;
+    explicit render_state(SDL_Renderer* render) noexcept: render(render) {}
+
+    SDL_Renderer* renderer() const noexcept {
+        return render;
+    }
+
+    void renderer(SDL_Renderer* r) noexcept {
+        render = r;
+        invalidate();
+    }
+
+    // forgets the shadow state, to be called after the renderer is used directly
+    void invalidate() noexcept {
+        known = 0;
+    }
+
+    void draw_colour(const SDL_Color& c) noexcept {
+        if(needs(known_colour, colour_ == c)) {
+            colour_ = c;
+            SDL_SetRenderDrawColor(render, c.r, c.g, c.b, c.a);
+        }
+    }
+
+    colour draw_colour() noexcept {
+        if(!(known & known_colour)) {
+            SDL_GetRenderDrawColor(render, &colour_.r, &colour_.g, &colour_.b, &colour_.a);
+            known |= known_colour;
+        }
+        return { colour_.r, colour_.g, colour_.b, colour_.a };
+    }
+
+    void blend(SDL_BlendMode mode) noexcept {
+        if(needs(known_blend, blend_ == mode)) {
+            blend_ = mode;
+            SDL_SetRenderDrawBlendMode(render, mode);
+        }
+    }
+
+    void blend(sdl::blend_mode mode) noexcept {
+        blend(static_cast<SDL_BlendMode>(mode));
+    }
+
+    sdl::blend_mode blend() noexcept {
+        if(!(known & known_blend)) {
+            SDL_GetRenderDrawBlendMode(render, &blend_);
+            known |= known_blend;
+        }
+        return static_cast<sdl::blend_mode>(blend_);
+    }
+
+    void target(SDL_Texture* texture) noexcept {
+        if(needs(known_target, target_ == texture)) {
+            target_ = texture;
+            SDL_SetRenderTarget(render, texture);
+            // SDL resets the viewport, clip rect and scale when switching targets
+            known &= ~(known_viewport | known_clip | known_scale);
+        }
+    }
+
+    SDL_Texture* target() noexcept {
+        if(!(known & known_target)) {
+            target_ = SDL_GetRenderTarget(render);
+            known |= known_target;
+        }
+        return target_;
+    }
+
+    void viewport(const rect& area) noexcept {
+        if(needs(known_viewport, viewport_ == area)) {
+            viewport_ = area;
+            SDL_RenderSetViewport(render, &viewport_);
+        }
+    }
+
+    rect viewport() noexcept {
+        if(!(known & known_viewport)) {
+            SDL_RenderGetViewport(render, &viewport_);
+            known |= known_viewport;
+        }
+        return viewport_;
+    }
+
+    // an empty area clips everything away, disable_clip draws everywhere again
+    void clip(const rect& area) noexcept {
+        if(needs(known_clip, clipping && clip_ == area)) {
+            clipping = true;
+            clip_ = area;
+            // SDL turns clipping off for negative sizes
+            rect nothing(area.x, area.y, 0, 0);
+            SDL_RenderSetClipRect(render, area.empty() ? &nothing : &clip_);
+        }
+    }
+
+    void disable_clip() noexcept {
+        if(needs(known_clip, !clipping)) {
+            clipping = false;
+            clip_ = rect();
+            SDL_RenderSetClipRect(render, nullptr);
+        }
+    }
+
+    rect clip() noexcept {
+        query_clip();
+        return clip_;
+    }
+
+    bool clip_enabled() noexcept {
+        query_clip();
+        return clipping;
+    }
+
+    void scale(float x, float y) noexcept {
+        if(needs(known_scale, scale_x == x && scale_y == y)) {
+            scale_x = x;
+            scale_y = y;
+            SDL_RenderSetScale(render, x, y);
+            // SDL scales the clip rect when it's set, so the same rect now covers another area
+            known &= ~known_clip;
+        }
+    }
+
+    vectorf scale() noexcept {
+        if(!(known & known_scale)) {
+            SDL_RenderGetScale(render, &scale_x, &scale_y);
+            known |= known_scale;
+        }
+        return { scale_x, scale_y };
+    }
+
+    // a translation applied by drawables to their coordinates, SDL has no way of
+    // translating everything so this is kept entirely on the gum side
+    void offset(int x, int y) noexcept {
+        offset_.x = x;
+        offset_.y = y;
+    }
+
+    void offset(const vector& amount) noexcept {
+        offset_ = amount;
+    }
+
+    vector offset() const noexcept {
+        return offset_;
+    }
+
+    bool translated() const noexcept {
+        return offset_.x != 0 || offset_.y != 0;
+    }
+
+    SDL_Point translate(int x, int y) const noexcept {
+        return { x + offset_.x, y + offset_.y };
+    }
+
+    SDL_Rect translate(const SDL_Rect& area) const noexcept {
+        return { area.x + offset_.x, area.y + offset_.y, area.w, area.h };
+    }
+
+    // returns the input as is when there's no offset, otherwise a translated
+    // copy that stays valid until the next call
+    const SDL_Point* translate(const SDL_Point* points, std::size_t count) {
+        if(!translated()) {
+            return points;
+        }
+
+        moved_points.resize(count);
+        for(std::size_t i = 0; i < count; ++i) {
+            moved_points[i] = translate(points[i].x, points[i].y);
+        }
+        return moved_points.data();
+    }
+
+    const SDL_Rect* translate(const SDL_Rect* rects, std::size_t count) {
+        if(!translated()) {
+            return rects;
+        }
+
+        moved_rects.resize(count);
+        for(std::size_t i = 0; i < count; ++i) {
+            moved_rects[i] = translate(rects[i]);
+        }
+        return moved_rects.data();
+    }
+
+#if defined(GUM_HAS_RENDER_FLOAT)
+    SDL_FPoint translate(float x, float y) const noexcept {
+        return { x + offset_.x, y + offset_.y };
+    }
+
+    SDL_FRect translate(const SDL_FRect& area) const noexcept {
+        return { area.x + offset_.x, area.y + offset_.y, area.w, area.h };
+    }
+
+    const SDL_FPoint* translate(const SDL_FPoint* points, std::size_t count) {
+        if(!translated()) {
+            return points;
+        }
+
+        moved_fpoints.resize(count);
+        for(std::size_t i = 0; i < count; ++i) {
+            moved_fpoints[i] = translate(points[i].x, points[i].y);
+        }
+        return moved_fpoints.data();
+    }
+
+    const SDL_FRect* translate(const SDL_FRect* rects, std::size_t count) {
+        if(!translated()) {
+            return rects;
+        }
+
+        moved_frects.resize(count);
+        for(std::size_t i = 0; i < count; ++i) {
+            moved_frects[i] = translate(rects[i]);
+        }
+        return moved_frects.data();
+    }
+#else
+    // without floating point rendering the coordinates are rounded instead
+    SDL_Point translate(float x, float y) const noexcept {
+        return translate(static_cast<int>(std::lround(x)), static_cast<int>(std::lround(y)));
+    }
+
+    SDL_Rect translate(const detail::frect& area) const noexcept {
+        return { static_cast<int>(std::lround(area.x)) + offset_.x, static_cast<int>(std::lround(area.y)) + offset_.y,
+                 static_cast<int>(std::lround(area.w)), static_cast<int>(std::lround(area.h)) };
+    }
+
+    const SDL_Point* translate(const detail::fpoint* points, std::size_t count) {
+        moved_points.resize(count);
+        for(std::size_t i = 0; i < count; ++i) {
+            moved_points[i] = translate(points[i].x, points[i].y);
+        }
+        return moved_points.data();
+    }
+
+    const SDL_Rect* translate(const detail::frect* rects, std::size_t count) {
+        moved_rects.resize(count);
+        for(std::size_t i = 0; i < count; ++i) {
+            moved_rects[i] = translate(rects[i]);
+        }
+        return moved_rects.data();
+    }
+#endif // GUM_HAS_RENDER_FLOAT
+
+#if defined(GUM_HAS_RENDER_GEOMETRY)
+    const SDL_Vertex* translate(const SDL_Vertex* vertices, std::size_t count) {
+        if(!translated()) {
+            return vertices;
+        }
+
+        auto x = static_cast<float>(offset_.x);
+        auto y = static_cast<float>(offset_.y);
+        moved_vertices.assign(vertices, vertices + count);
+        for(auto&& vertex : moved_vertices) {
+            vertex.position.x += x;
+            vertex.position.y += y;
+        }
+        return moved_vertices.data();
+    }
+#endif // GUM_HAS_RENDER_GEOMETRY
+
+    render_stats stats() const noexcept {
+        return stats_;
+    }
+
+    void reset_stats() noexcept {
+        stats_ = render_stats();
+    }
+};
+} // sdl
+
+#endif // GUM_VIDEO_RENDER_STATE_HPP
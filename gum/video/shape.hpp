@@ -0,0 +1,322 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_VIDEO_SHAPE_HPP
+#define GUM_VIDEO_SHAPE_HPP
+
+#include <gum/core/config.hpp>
+#include <gum/detail/bounds.hpp>
+#include <gum/detail/tessellate.hpp>
+#include <gum/video/colour.hpp>
+#include <gum/video/rect.hpp>
+#include <gum/video/render_state.hpp>
+#include <gum/video/vector.hpp>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#if !defined(GUM_HAS_RENDER_GEOMETRY)
+#error "sdl::shape requires SDL 2.0.18 or higher"
+#endif
+
+namespace sdl {
+struct shape_batch;
+
+// a filled polygon that is triangulated once and drawn with a single SDL_RenderGeometry
+// call. The triangles are only recalculated when the outline changes, moving or
+// recolouring the shape only rewrites the vertices
+struct shape {
+private:
+    friend struct shape_batch;
+
+    std::vector<SDL_FPoint> points;  // the outline, relative to the position
+    vectorf position_;
+    colour c = colour::white();
+    mutable std::vector<SDL_Vertex> vertices;
+    mutable std::vector<int> indices;
+    mutable std::vector<int> scratch;
+    mutable rectf extent;
+    mutable bool stale_indices = true;
+    mutable bool stale_vertices = true;
+    mutable bool stale_extent = true;
+    mutable bool simple = true;
+
+    void changed() noexcept {
+        stale_indices = true;
+        stale_vertices = true;
+        stale_extent = true;
+    }
+
+    void update() const {
+        if(stale_indices) {
+            indices.clear();
+            if(detail::is_convex(points.data(), points.size())) {
+                detail::triangulate_fan(points.size(), 0, indices);
+                simple = true;
+            }
+            else {
+                simple = detail::triangulate_ears(points.data(), points.size(), 0, indices, scratch) &&
+                         !detail::self_intersects(points.data(), points.size());
+            }
+            stale_indices = false;
+        }
+
+        if(stale_vertices) {
+            vertices.resize(points.size());
+            for(std::size_t i = 0; i < points.size(); ++i) {
+                vertices[i].position = { points[i].x + position_.x, points[i].y + position_.y };
+                vertices[i].color = c;
+                vertices[i].tex_coord = { 0.0f, 0.0f };
+            }
+            stale_vertices = false;
+        }
+    }
+public:
+    shape() = default;
+
+    // a circle made of enough segments to look round at its size unless specified
+    static shape circle(const vectorf& center, float radius, std::size_t segments = 0) {
+        shape result;
+        if(segments < 3) {
+            segments = detail::circle_segments(radius);
+        }
+
+        result.points.reserve(segments);
+        detail::add_arc(result.points, 0.0f, 0.0f, radius, 0.0f, 6.2831853f * (segments - 1) / segments, segments - 1);
+        result.position_ = center;
+        return result;
+    }
+
+    static shape rectangle(const rectf& area) {
+        shape result;
+        result.add(area.x, area.y);
+        result.add(area.x + area.w, area.y);
+        result.add(area.x + area.w, area.y + area.h);
+        result.add(area.x, area.y + area.h);
+        return result;
+    }
+
+    // the radius is clamped to half of the shorter side
+    static shape rounded_rectangle(const rectf& area, float radius) {
+        auto limit = (area.w < area.h ? area.w : area.h) * 0.5f;
+        radius = radius > limit ? limit : radius;
+        if(radius <= 0.0f) {
+            return rectangle(area);
+        }
+
+        shape result;
+        auto segments = detail::circle_segments(radius) / 4;
+        const float quarter = 1.5707963f;
+        auto left = area.x + radius;
+        auto top = area.y + radius;
+        auto right = area.x + area.w - radius;
+        auto bottom = area.y + area.h - radius;
+        detail::add_arc(result.points, right, bottom, radius, 0.0f, quarter, segments);
+        detail::add_arc(result.points, left, bottom, radius, quarter, quarter, segments);
+        detail::add_arc(result.points, left, top, radius, quarter * 2.0f, quarter, segments);
+        detail::add_arc(result.points, right, top, radius, quarter * 3.0f, quarter, segments);
+        return result;
+    }
+
+    // a line with a thickness in pixels, e.g. for lines wider than SDL_RenderDrawLine allows
+    static shape line(const vectorf& from, const vectorf& to, float thickness) {
+        shape result;
+        auto dx = to.x - from.x;
+        auto dy = to.y - from.y;
+        auto length = std::sqrt(dx * dx + dy * dy);
+        if(length == 0.0f) {
+            return result;
+        }
+
+        auto nx = -dy / length * thickness * 0.5f;
+        auto ny = dx / length * thickness * 0.5f;
+        result.add(from.x + nx, from.y + ny);
+        result.add(to.x + nx, to.y + ny);
+        result.add(to.x - nx, to.y - ny);
+        result.add(from.x - nx, from.y - ny);
+        return result;
+    }
+
+    void add(float x, float y) {
+        points.push_back({ x, y });
+        changed();
+    }
+
+    void add(const vectorf& pos) {
+        add(pos.x, pos.y);
+    }
+
+    void point(std::size_t index, const vectorf& pos) noexcept {
+        points[index] = pos;
+        changed();
+    }
+
+    vectorf point(std::size_t index) const noexcept {
+        return { points[index].x, points[index].y };
+    }
+
+    void clear() noexcept {
+        points.clear();
+        changed();
+    }
+
+    std::size_t size() const noexcept {
+        return points.size();
+    }
+
+    bool empty() const noexcept {
+        return points.empty();
+    }
+
+    void reserve(std::size_t count) {
+        points.reserve(count);
+    }
+
+    const SDL_FPoint* data() const noexcept {
+        return points.data();
+    }
+
+    // the outline is relative to the position
+    void position(const vectorf& pos) noexcept {
+        position_ = pos;
+        stale_vertices = true;
+        stale_extent = true;
+    }
+
+    vectorf position() const noexcept {
+        return position_;
+    }
+
+    void move(const vectorf& amount) noexcept {
+        position(position_ + amount);
+    }
+
+    void fill(colour fill_colour) noexcept {
+        c = fill_colour;
+        stale_vertices = true;
+    }
+
+    colour fill() const noexcept {
+        return c;
+    }
+
+    // whether the outline could be triangulated and none of its edges cross
+    bool is_simple() const {
+        update();
+        return simple;
+    }
+
+    rect bounds() const noexcept {
+        if(stale_extent) {
+            float x1 = 0, y1 = 0, x2 = 0, y2 = 0;
+            for(std::size_t i = 0; i < points.size(); ++i) {
+                auto&& p = points[i];
+                x1 = i == 0 || p.x < x1 ? p.x : x1;
+                y1 = i == 0 || p.y < y1 ? p.y : y1;
+                x2 = i == 0 || p.x > x2 ? p.x : x2;
+                y2 = i == 0 || p.y > y2 ? p.y : y2;
+            }
+            extent = rectf(x1 + position_.x, y1 + position_.y, x2 - x1, y2 - y1);
+            stale_extent = false;
+        }
+        return extent.bounds();
+    }
+
+    void draw(render_state& state) const {
+        update();
+        if(indices.empty()) {
+            return;
+        }
+
+        auto* moved = state.translate(vertices.data(), vertices.size());
+        SDL_RenderGeometry(state.renderer(), nullptr, moved, static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(indices.size()));
+    }
+
+    void draw(SDL_Renderer* render) const {
+        render_state state(render);
+        draw(state);
+    }
+};
+
+// many shapes drawn together with a single SDL_RenderGeometry call. The shapes are
+// copied in as they are when added so changing them afterwards has no effect
+struct shape_batch {
+private:
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    std::size_t count = 0;
+    detail::bounds_accumulator area;
+public:
+    shape_batch() = default;
+
+    void add(const shape& s) {
+        s.update();
+        if(s.indices.empty()) {
+            return;
+        }
+
+        auto base = static_cast<int>(vertices.size());
+        vertices.insert(vertices.end(), s.vertices.begin(), s.vertices.end());
+        for(auto&& index : s.indices) {
+            indices.push_back(base + index);
+        }
+
+        auto&& b = s.bounds();
+        area.add(b.x, b.y, b.w, b.h);
+        ++count;
+    }
+
+    void clear() noexcept {
+        vertices.clear();
+        indices.clear();
+        area.clear();
+        count = 0;
+    }
+
+    std::size_t size() const noexcept {
+        return count;
+    }
+
+    bool empty() const noexcept {
+        return count == 0;
+    }
+
+    rect bounds() const noexcept {
+        return area.result();
+    }
+
+    void draw(render_state& state) const {
+        if(indices.empty()) {
+            return;
+        }
+
+        auto* moved = state.translate(vertices.data(), vertices.size());
+        SDL_RenderGeometry(state.renderer(), nullptr, moved, static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(indices.size()));
+    }
+
+    void draw(SDL_Renderer* render) const {
+        render_state state(render);
+        draw(state);
+    }
+};
+} // sdl
+
+#endif // GUM_VIDEO_SHAPE_HPP
@@ -23,6 +23,10 @@
 #include <gum/video/texture.hpp>
 #include <gum/video/rect.hpp>
 #include <gum/video/vector.hpp>
+#include <gum/video/command_buffer.hpp>
+#include <gum/video/render_state.hpp>
+#include <gum/detail/render_calls.hpp>
+#include <cmath>
 
 namespace sdl {
 enum class flip : int {
@@ -35,23 +39,25 @@ enum class flip : int {
 struct sprite {
 private:
     rect subtex;                            // area of the texture used to render
-    rect destination;                       // stores the location amongst other things
+    rectf destination;                      // stores the location amongst other things
     vector center;                          // the center of the sprite
     double angle = 0;                       // rotation in degrees
-    const texture* tex = nullptr;           // non owning
+    const sdl::texture* tex = nullptr;      // non owning
     SDL_RendererFlip flip_ = SDL_FLIP_NONE; // the flip position
+    uint8_t layer_ = 0;                     // draw order when recorded, see command_buffer
+    uint16_t depth_ = 0;
 public:
     sprite() = default;
-    sprite(const texture& tex) {
+    sprite(const sdl::texture& tex) {
         texture(tex);
     }
 
-    sprite(const texture& tex, const rect& area) noexcept: subtex(area), tex(&tex) {
-        destination.w = area.w;
-        destination.h = area.h;
+    sprite(const sdl::texture& tex, const rect& area) noexcept: subtex(area), tex(&tex) {
+        destination.w = static_cast<float>(area.w);
+        destination.h = static_cast<float>(area.h);
     }
 
-    void texture(const texture& tex, bool recalculate = true) {
+    void texture(const sdl::texture& tex, bool recalculate = true) {
         this->tex = &tex;
         // sets the area of the texture to the entire texture
         if(recalculate) {
@@ -60,8 +66,8 @@ public:
             subtex.y = 0;
             subtex.w = texture_size.x;
             subtex.h = texture_size.y;
-            destination.w = texture_size.x;
-            destination.h = texture_size.y;
+            destination.w = static_cast<float>(texture_size.x);
+            destination.h = static_cast<float>(texture_size.y);
         }
     }
 
@@ -71,8 +77,8 @@ public:
 
     void subtexture(const rect& area) noexcept {
         subtex = area;
-        destination.w = area.w;
-        destination.h = area.h;
+        destination.w = static_cast<float>(area.w);
+        destination.h = static_cast<float>(area.h);
     }
 
     rect subtexture() const noexcept {
@@ -80,27 +86,43 @@ public:
     }
 
     void position(int x, int y) noexcept {
-        destination.x = x;
-        destination.y = y;
+        destination.x = static_cast<float>(x);
+        destination.y = static_cast<float>(y);
     }
 
     void position(const vector& pos) noexcept {
         position(pos.x, pos.y);
     }
 
+    // sub-pixel positions are drawn as is when the renderer supports it
+    void position(const vectorf& pos) noexcept {
+        destination.x = pos.x;
+        destination.y = pos.y;
+    }
+
+    // rounded to the nearest pixel, see positionf for the exact position
     vector position() const noexcept {
+        return positionf().rounded();
+    }
+
+    vectorf positionf() const noexcept {
         return { destination.x, destination.y };
     }
 
     void move(int x, int y) noexcept {
-        destination.x += x;
-        destination.y += y;
+        destination.x += static_cast<float>(x);
+        destination.y += static_cast<float>(y);
     }
 
     void move(const vector& pos) noexcept {
         move(pos.x, pos.y);
     }
 
+    void move(const vectorf& amount) noexcept {
+        destination.x += amount.x;
+        destination.y += amount.y;
+    }
+
     void rotation(double degrees) noexcept {
         angle = degrees;
     }
@@ -134,9 +156,82 @@ public:
         return static_cast<sdl::flip>(flip_);
     }
 
+    // sprites on higher layers are drawn over the ones below when recorded
+    void layer(uint8_t l) noexcept {
+        layer_ = l;
+    }
+
+    uint8_t layer() const noexcept {
+        return layer_;
+    }
+
+    // orders the sprites within a layer when the buffer orders by depth
+    void depth(uint16_t d) noexcept {
+        depth_ = d;
+    }
+
+    uint16_t depth() const noexcept {
+        return depth_;
+    }
+
+    // the area covered on screen, rotated sprites get the box around the rotated corners
+    rect bounds() const noexcept {
+        if(angle == 0.0) {
+            return destination.bounds();
+        }
+
+        auto radians = angle * 0.017453292519943295;
+        auto cosine = std::cos(radians);
+        auto sine = std::sin(radians);
+        double cx = center.x;
+        double cy = center.y;
+        double xs[] = { -cx, destination.w - cx };
+        double ys[] = { -cy, destination.h - cy };
+        double min_x = 0, min_y = 0, max_x = 0, max_y = 0;
+        bool first = true;
+        for(auto&& x : xs) {
+            for(auto&& y : ys) {
+                auto rx = x * cosine - y * sine;
+                auto ry = x * sine + y * cosine;
+                min_x = first || rx < min_x ? rx : min_x;
+                max_x = first || rx > max_x ? rx : max_x;
+                min_y = first || ry < min_y ? ry : min_y;
+                max_y = first || ry > max_y ? ry : max_y;
+                first = false;
+            }
+        }
+
+        // rounded outwards with an extra pixel for the rasteriser
+        min_x += destination.x + center.x;
+        max_x += destination.x + center.x;
+        min_y += destination.y + center.y;
+        max_y += destination.y + center.y;
+        auto x = static_cast<int>(std::floor(min_x)) - 1;
+        auto y = static_cast<int>(std::floor(min_y)) - 1;
+        auto w = static_cast<int>(std::ceil(max_x)) + 1 - x;
+        auto h = static_cast<int>(std::ceil(max_y)) + 1 - y;
+        return { x, y, w, h };
+    }
+
     void draw(SDL_Renderer* render) const {
+        render_state state(render);
+        draw(state);
+    }
+
+    void draw(render_state& state) const {
+        // copying textures doesn't depend on the draw state besides the offset
         // error reporting is suppressed for performance reasons
-        SDL_RenderCopyEx(render, tex ? tex->data() : nullptr, &subtex, &destination, angle, &center, flip_);
+        detail::copy(state.renderer(), tex ? tex->data() : nullptr, subtex, state.translate(destination), angle, center, flip_);
+    }
+
+    void record(command_buffer& buffer) const {
+        record(buffer, layer_, depth_);
+    }
+
+    void record(command_buffer& buffer, uint8_t layer, uint16_t depth = 0) const {
+        if(tex != nullptr) {
+            buffer.copy(tex->data(), subtex, static_cast<const detail::frect&>(destination), angle, center, flip_, layer, depth);
+        }
     }
 };
 } // sdl
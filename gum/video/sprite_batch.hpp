@@ -0,0 +1,212 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_VIDEO_SPRITE_BATCH_HPP
+#define GUM_VIDEO_SPRITE_BATCH_HPP
+
+#include <gum/core/config.hpp>
+#include <gum/detail/bounds.hpp>
+#include <gum/video/render_state.hpp>
+#include <gum/video/sprite.hpp>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#if !defined(GUM_HAS_RENDER_GEOMETRY)
+#error "sdl::sprite_batch requires SDL 2.0.18 or higher"
+#endif
+
+namespace sdl {
+struct sprite_batch {
+private:
+    struct group {
+        const sdl::texture* tex = nullptr;  // non owning
+        float width = 1.0f;                 // cached texture size used for
+        float height = 1.0f;                // calculating texture coordinates
+        std::vector<SDL_Vertex> vertices;
+    };
+
+    std::vector<group> groups;  // groups past `active` are kept around for their memory
+    std::vector<int> indices;   // shared between groups since the quad layout is always the same
+    std::size_t active = 0;
+    std::size_t last = 0;       // the group that was last added to
+    std::size_t count = 0;
+    detail::bounds_accumulator area;
+
+    group& find_group(const sdl::texture* tex) {
+        if(last < active && groups[last].tex == tex) {
+            return groups[last];
+        }
+
+        for(std::size_t i = 0; i < active; ++i) {
+            if(groups[i].tex == tex) {
+                last = i;
+                return groups[i];
+            }
+        }
+
+        if(active == groups.size()) {
+            groups.emplace_back();
+        }
+
+        last = active++;
+        auto&& result = groups[last];
+        auto&& size = tex->size();
+        result.tex = tex;
+        result.width = static_cast<float>(size.x);
+        result.height = static_cast<float>(size.y);
+        result.vertices.clear();
+        return result;
+    }
+
+    void grow_indices(std::size_t quads) {
+        auto current = indices.size() / 6;
+        if(current >= quads) {
+            return;
+        }
+
+        indices.reserve(quads * 6);
+        for(auto i = current; i < quads; ++i) {
+            auto base = static_cast<int>(i * 4);
+            indices.push_back(base);
+            indices.push_back(base + 1);
+            indices.push_back(base + 2);
+            indices.push_back(base + 2);
+            indices.push_back(base + 3);
+            indices.push_back(base);
+        }
+    }
+public:
+    sprite_batch() = default;
+
+    void reserve(std::size_t sprites) {
+        grow_indices(sprites);
+    }
+
+    void add(const sprite& s) {
+        auto* tex = s.texture();
+        if(tex == nullptr || !*tex) {
+            return;
+        }
+
+        auto&& g = find_group(tex);
+        auto&& src = s.subtexture();
+        auto&& pos = s.positionf();
+        auto&& center = s.origin();
+        auto f = static_cast<int>(s.flip());
+
+        // texture coordinates, with the flip applied by swapping the edges
+        float u0 = src.x / g.width;
+        float v0 = src.y / g.height;
+        float u1 = (src.x + src.w) / g.width;
+        float v1 = (src.y + src.h) / g.height;
+
+        if(f & SDL_FLIP_HORIZONTAL) {
+            std::swap(u0, u1);
+        }
+
+        if(f & SDL_FLIP_VERTICAL) {
+            std::swap(v0, v1);
+        }
+
+        // corners relative to the origin, which is where the rotation takes place
+        float cx = pos.x + center.x;
+        float cy = pos.y + center.y;
+        float left = static_cast<float>(-center.x);
+        float top = static_cast<float>(-center.y);
+        float right = left + src.w;
+        float bottom = top + src.h;
+
+        SDL_FPoint corners[4] = {
+            { left, top }, { right, top }, { right, bottom }, { left, bottom }
+        };
+
+        auto angle = s.rotation();
+        if(angle != 0.0) {
+            // SDL_RenderCopyEx rotates clockwise in degrees
+            auto radians = angle * 0.017453292519943295;
+            auto cosine = static_cast<float>(std::cos(radians));
+            auto sine = static_cast<float>(std::sin(radians));
+            for(auto&& p : corners) {
+                auto x = p.x;
+                p.x = x * cosine - p.y * sine;
+                p.y = x * sine + p.y * cosine;
+            }
+        }
+
+        const SDL_Color white = { 255, 255, 255, 255 };
+        const SDL_FPoint uvs[4] = { { u0, v0 }, { u1, v0 }, { u1, v1 }, { u0, v1 } };
+        for(int i = 0; i < 4; ++i) {
+            SDL_Vertex vertex = { { cx + corners[i].x, cy + corners[i].y }, white, uvs[i] };
+            g.vertices.push_back(vertex);
+            auto x = static_cast<int>(std::floor(vertex.position.x));
+            auto y = static_cast<int>(std::floor(vertex.position.y));
+            area.add(x, y, 1, 1);
+        }
+
+        grow_indices(g.vertices.size() / 4);
+        ++count;
+    }
+
+    void clear() noexcept {
+        for(std::size_t i = 0; i < active; ++i) {
+            groups[i].vertices.clear();
+        }
+        active = 0;
+        last = 0;
+        count = 0;
+        area.clear();
+    }
+
+    std::size_t size() const noexcept {
+        return count;
+    }
+
+    bool empty() const noexcept {
+        return count == 0;
+    }
+
+    std::size_t textures() const noexcept {
+        return active;
+    }
+
+    // the area covered by every sprite in the batch
+    rect bounds() const noexcept {
+        return area.result();
+    }
+
+    void draw(render_state& state) const {
+        // error reporting is suppressed for performance reasons
+        for(std::size_t i = 0; i < active; ++i) {
+            auto&& g = groups[i];
+            auto vertices = static_cast<int>(g.vertices.size());
+            auto* data = state.translate(g.vertices.data(), g.vertices.size());
+            SDL_RenderGeometry(state.renderer(), g.tex->data(), data, vertices, indices.data(), (vertices / 4) * 6);
+        }
+    }
+
+    void draw(SDL_Renderer* render) const {
+        render_state state(render);
+        draw(state);
+    }
+};
+} // sdl
+
+#endif // GUM_VIDEO_SPRITE_BATCH_HPP
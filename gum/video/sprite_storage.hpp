@@ -0,0 +1,323 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_VIDEO_SPRITE_STORAGE_HPP
+#define GUM_VIDEO_SPRITE_STORAGE_HPP
+
+#include <gum/detail/render_calls.hpp>
+#include <gum/detail/slot_map.hpp>
+#include <gum/video/command_buffer.hpp>
+#include <gum/video/rect.hpp>
+#include <gum/video/render_state.hpp>
+#include <gum/video/sprite.hpp>
+#include <gum/video/texture.hpp>
+#include <gum/video/vector.hpp>
+#include <gum/video/vector_array.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sdl {
+// refers to a sprite in a sprite_storage, stays valid until the sprite is erased
+struct sprite_handle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    constexpr sprite_handle() noexcept = default;
+    constexpr sprite_handle(uint32_t index, uint32_t generation) noexcept: index(index), generation(generation) {}
+};
+
+constexpr bool operator==(const sprite_handle& lhs, const sprite_handle& rhs) noexcept {
+    return lhs.index == rhs.index && lhs.generation == rhs.generation;
+}
+
+constexpr bool operator!=(const sprite_handle& lhs, const sprite_handle& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+// many sprites stored as separate dense arrays of each of their members so that
+// updating or drawing all of them walks through memory linearly. Erasing moves the
+// last sprite into the hole, handles keep track of where each sprite went
+struct sprite_storage {
+private:
+    vector_array positions_;
+    std::vector<rect> sources;
+    std::vector<float> angles;
+    std::vector<vector> origins;
+    std::vector<SDL_Texture*> textures;
+    std::vector<uint8_t> flips;
+    std::vector<uint8_t> layers;
+    std::vector<uint16_t> depths_;
+    detail::slot_table slots;
+
+    detail::frect destination(std::size_t i) const noexcept {
+        auto&& src = sources[i];
+        return { positions_.x()[i], positions_.y()[i], static_cast<float>(src.w), static_cast<float>(src.h) };
+    }
+public:
+    sprite_storage() = default;
+
+    void reserve(std::size_t count) {
+        positions_.reserve(count);
+        sources.reserve(count);
+        angles.reserve(count);
+        origins.reserve(count);
+        textures.reserve(count);
+        flips.reserve(count);
+        layers.reserve(count);
+        depths_.reserve(count);
+        slots.reserve(count);
+    }
+
+    sprite_handle insert(const sprite& s) {
+        auto* tex = s.texture();
+        auto&& pos = s.positionf();
+        positions_.push_back(pos.x, pos.y);
+        sources.push_back(s.subtexture());
+        angles.push_back(static_cast<float>(s.rotation()));
+        origins.push_back(s.origin());
+        textures.push_back(tex ? tex->data() : nullptr);
+        flips.push_back(static_cast<uint8_t>(s.flip()));
+        layers.push_back(s.layer());
+        depths_.push_back(s.depth());
+        auto slot = slots.insert();
+        return { slot, slots.generation(slot) };
+    }
+
+    sprite_handle insert(const sdl::texture& tex, const rect& area, const vectorf& pos) {
+        sprite s(tex, area);
+        s.position(pos);
+        return insert(s);
+    }
+
+    bool contains(sprite_handle h) const noexcept {
+        return slots.contains(h.index, h.generation);
+    }
+
+    // moves the last sprite into the place of the erased one
+    void erase(sprite_handle h) noexcept {
+        if(!contains(h)) {
+            return;
+        }
+
+        auto i = slots.erase(h.index);
+        auto last = slots.size(); // the old last index, the table already dropped it
+        if(i != last) {
+            auto&& moved = positions_[last];
+            positions_.set(i, moved.x, moved.y);
+            sources[i] = sources[last];
+            angles[i] = angles[last];
+            origins[i] = origins[last];
+            textures[i] = textures[last];
+            flips[i] = flips[last];
+            layers[i] = layers[last];
+            depths_[i] = depths_[last];
+        }
+
+        positions_.resize(last);
+        sources.pop_back();
+        angles.pop_back();
+        origins.pop_back();
+        textures.pop_back();
+        flips.pop_back();
+        layers.pop_back();
+        depths_.pop_back();
+    }
+
+    // every handle becomes invalid
+    void clear() noexcept {
+        slots.clear();
+        positions_.clear();
+        sources.clear();
+        angles.clear();
+        origins.clear();
+        textures.clear();
+        flips.clear();
+        layers.clear();
+        depths_.clear();
+    }
+
+    std::size_t size() const noexcept {
+        return slots.size();
+    }
+
+    bool empty() const noexcept {
+        return slots.empty();
+    }
+
+    // the position of the sprite in the dense arrays, which changes when other sprites are erased
+    std::size_t index(sprite_handle h) const noexcept {
+        return slots.index(h.index);
+    }
+
+    sprite_handle handle(std::size_t index) const noexcept {
+        auto slot = slots.slot(index);
+        return { slot, slots.generation(slot) };
+    }
+
+    void position(sprite_handle h, const vectorf& pos) noexcept {
+        positions_.set(slots.index(h.index), pos.x, pos.y);
+    }
+
+    vectorf position(sprite_handle h) const noexcept {
+        auto&& pos = positions_[slots.index(h.index)];
+        return { pos.x, pos.y };
+    }
+
+    void move(sprite_handle h, const vectorf& amount) noexcept {
+        position(h, position(h) + amount);
+    }
+
+    void rotation(sprite_handle h, float degrees) noexcept {
+        angles[slots.index(h.index)] = degrees;
+    }
+
+    float rotation(sprite_handle h) const noexcept {
+        return angles[slots.index(h.index)];
+    }
+
+    void subtexture(sprite_handle h, const rect& area) noexcept {
+        sources[slots.index(h.index)] = area;
+    }
+
+    rect subtexture(sprite_handle h) const noexcept {
+        return sources[slots.index(h.index)];
+    }
+
+    void origin(sprite_handle h, const vector& center) noexcept {
+        origins[slots.index(h.index)] = center;
+    }
+
+    vector origin(sprite_handle h) const noexcept {
+        return origins[slots.index(h.index)];
+    }
+
+    void flip(sprite_handle h, sdl::flip f) noexcept {
+        flips[slots.index(h.index)] = static_cast<uint8_t>(f);
+    }
+
+    sdl::flip flip(sprite_handle h) const noexcept {
+        return static_cast<sdl::flip>(flips[slots.index(h.index)]);
+    }
+
+    void layer(sprite_handle h, uint8_t l) noexcept {
+        layers[slots.index(h.index)] = l;
+    }
+
+    uint8_t layer(sprite_handle h) const noexcept {
+        return layers[slots.index(h.index)];
+    }
+
+    void depth(sprite_handle h, uint16_t d) noexcept {
+        depths_[slots.index(h.index)] = d;
+    }
+
+    uint16_t depth(sprite_handle h) const noexcept {
+        return depths_[slots.index(h.index)];
+    }
+
+    // the positions in dense order, meant for bulk updates e.g.
+    // storage.positions().multiply_add(velocities, dt)
+    vector_array& positions() noexcept {
+        return positions_;
+    }
+
+    const vector_array& positions() const noexcept {
+        return positions_;
+    }
+
+    // the rotations in dense order
+    float* rotations() noexcept {
+        return angles.data();
+    }
+
+    const float* rotations() const noexcept {
+        return angles.data();
+    }
+
+    // the depths in dense order, e.g. for ordering by the y coordinate every frame
+    uint16_t* depths() noexcept {
+        return depths_.data();
+    }
+
+    const uint16_t* depths() const noexcept {
+        return depths_.data();
+    }
+
+    void move_all(float dx, float dy) noexcept {
+        positions_.add(dx, dy);
+    }
+
+    // adds deltas[i] to the position of the ith sprite in dense order
+    void move_all(const vector_array& deltas) noexcept {
+        positions_.add(deltas);
+    }
+
+    void rotate_all(float degrees) noexcept {
+        for(auto&& angle : angles) {
+            angle += degrees;
+        }
+    }
+
+    // adds degrees[i] to the rotation of the ith sprite in dense order
+    void rotate_all(const float* degrees) noexcept {
+        for(std::size_t i = 0; i < angles.size(); ++i) {
+            angles[i] += degrees[i];
+        }
+    }
+
+    void draw(render_state& state) const {
+        auto* render = state.renderer();
+        for(std::size_t i = 0; i < slots.size(); ++i) {
+            // unrotated and unflipped sprites take the cheaper SDL_RenderCopy path
+            if(textures[i] != nullptr) {
+                detail::copy(render, textures[i], sources[i], state.translate(destination(i)), angles[i], origins[i],
+                             static_cast<SDL_RendererFlip>(flips[i]));
+            }
+        }
+    }
+
+    void draw(SDL_Renderer* render) const {
+        render_state state(render);
+        draw(state);
+    }
+
+    // records every sprite with its own layer and depth
+    void record(command_buffer& buffer) const {
+        for(std::size_t i = 0; i < slots.size(); ++i) {
+            if(textures[i] != nullptr) {
+                buffer.copy(textures[i], sources[i], destination(i), angles[i], origins[i],
+                            static_cast<SDL_RendererFlip>(flips[i]), layers[i], depths_[i]);
+            }
+        }
+    }
+
+    // records every sprite with the same layer and depth
+    void record(command_buffer& buffer, uint8_t layer, uint16_t depth = 0) const {
+        for(std::size_t i = 0; i < slots.size(); ++i) {
+            if(textures[i] != nullptr) {
+                buffer.copy(textures[i], sources[i], destination(i), angles[i], origins[i],
+                            static_cast<SDL_RendererFlip>(flips[i]), layer, depth);
+            }
+        }
+    }
+};
+} // sdl
+
+#endif // GUM_VIDEO_SPRITE_STORAGE_HPP
@@ -0,0 +1,157 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_VIDEO_STREAMING_TEXTURE_HPP
+#define GUM_VIDEO_STREAMING_TEXTURE_HPP
+
+#include <gum/core/error.hpp>
+#include <gum/video/rect.hpp>
+#include <gum/video/texture.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sdl {
+// a texture whose contents are replaced often, e.g. every frame of a video. Whole
+// frames are written into the next of several textures in turn, so the one being
+// written to is never the one the renderer may still be reading from. Everything
+// is allocated up front so streaming frames doesn't allocate
+struct streaming_texture {
+private:
+    std::vector<texture> buffers;
+    std::size_t front = 0;  // the texture with the latest frame
+    int width_ = 0;
+    int height_ = 0;
+
+    texture& advance() noexcept {
+        front = (front + 1) % buffers.size();
+        return buffers[front];
+    }
+
+    // there's nothing to write to before create, which is reported like a failed SDL call
+    bool created() const {
+        if(buffers.empty()) {
+            SDL_SetError("streaming_texture used before being created");
+            return false;
+        }
+        return true;
+    }
+public:
+    streaming_texture() = default;
+
+    template<typename Window>
+    streaming_texture(int width, int height, const Window& win, std::size_t count = 2,
+                      uint32_t format = SDL_PIXELFORMAT_RGBA8888) {
+        create(width, height, win, count, format);
+    }
+
+    template<typename Window>
+    void create(int width, int height, const Window& win, std::size_t count = 2,
+                uint32_t format = SDL_PIXELFORMAT_RGBA8888) {
+        static_assert(detail::is_valid_renderer<Window>::value, "Type must either be an sdl::window or SDL_Renderer*");
+        buffers.clear();
+        buffers.resize(count == 0 ? 1 : count);
+        front = 0;
+        width_ = width;
+        height_ = height;
+        for(auto&& buffer : buffers) {
+            buffer.create(width, height, win, SDL_TEXTUREACCESS_STREAMING, format);
+            if(!buffer) {
+                return;
+            }
+        }
+    }
+
+    // locks the next texture for a whole new frame, which becomes the current one.
+    // Every pixel should be written since it still has the contents of an older frame
+    texture_lock lock() {
+        if(!created()) {
+            GUM_ERROR_HANDLER(texture_lock());
+        }
+        return advance().lock();
+    }
+
+    // changes part of the current frame, without moving to the next texture
+    texture_lock lock(const rect& area) {
+        if(!created()) {
+            GUM_ERROR_HANDLER(texture_lock());
+        }
+        return buffers[front].lock(area);
+    }
+
+    // uploads a whole new frame into the next texture, which becomes the current one
+    void update(const void* pixels, int pitch) {
+        if(!created()) {
+            GUM_ERROR_HANDLER_VOID();
+        }
+        advance().update(pixels, pitch);
+    }
+
+    // changes part of the current frame, without moving to the next texture
+    void update(const rect& area, const void* pixels, int pitch) {
+        if(!created()) {
+            GUM_ERROR_HANDLER_VOID();
+        }
+        buffers[front].update(area, pixels, pitch);
+    }
+
+    // uploads a whole new IYUV or YV12 frame into the next texture, see texture::update_yuv
+    void update_yuv(const uint8_t* y, int y_pitch, const uint8_t* u, int u_pitch, const uint8_t* v, int v_pitch) {
+        if(!created()) {
+            GUM_ERROR_HANDLER_VOID();
+        }
+        advance().update_yuv(y, y_pitch, u, u_pitch, v, v_pitch);
+    }
+
+#if defined(GUM_HAS_UPDATE_NV_TEXTURE)
+    // uploads a whole new NV12 or NV21 frame into the next texture, see texture::update_nv
+    void update_nv(const uint8_t* y, int y_pitch, const uint8_t* uv, int uv_pitch) {
+        if(!created()) {
+            GUM_ERROR_HANDLER_VOID();
+        }
+        advance().update_nv(y, y_pitch, uv, uv_pitch);
+    }
+#endif // GUM_HAS_UPDATE_NV_TEXTURE
+
+    // the texture with the latest frame, which changes after every whole frame.
+    // An empty texture before create
+    const texture& current() const noexcept {
+        static const texture none;
+        return buffers.empty() ? none : buffers[front];
+    }
+
+    SDL_Texture* data() const noexcept {
+        return buffers.empty() ? nullptr : buffers[front].data();
+    }
+
+    explicit operator bool() const noexcept {
+        return !buffers.empty() && static_cast<bool>(buffers.back());
+    }
+
+    std::size_t count() const noexcept {
+        return buffers.size();
+    }
+
+    SDL_Point size() const noexcept {
+        return { width_, height_ };
+    }
+};
+} // sdl
+
+#endif // GUM_VIDEO_STREAMING_TEXTURE_HPP
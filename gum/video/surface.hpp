@@ -75,6 +75,9 @@ public:
         load_file(filename);
     }
 
+    // takes ownership of a surface created elsewhere
+    explicit surface(SDL_Surface* image) noexcept: ptr(image) {}
+
     void load_file(const std::string& filename) {
         // delete surface if it's already active
         if(ptr != nullptr) {
@@ -91,6 +94,24 @@ public:
         }
     }
 
+    // loads an image from any SDL_RWops, e.g. one from asset_pack::rwops. The source
+    // is always closed
+    void load_rw(SDL_RWops* source) {
+        if(source == nullptr) {
+            ptr.reset(nullptr);
+            GUM_ERROR_HANDLER_VOID();
+        }
+
+    #ifndef GUM_IMG_DISABLED
+        ptr.reset(IMG_Load_RW(source, 1));
+    #else
+        ptr.reset(SDL_LoadBMP_RW(source, 1));
+    #endif
+        if(ptr == nullptr) {
+            GUM_ERROR_HANDLER_VOID();
+        }
+    }
+
     void create(int width, int height, int depth = 32) {
         ptr.reset(SDL_CreateRGBSurface(0, width, height, depth, red, green, blue, alpha));
         if(ptr == nullptr) {
@@ -22,6 +22,10 @@
 
 #include <gum/core/error.hpp>
 #include <gum/video/colour.hpp>
+#include <gum/video/rect.hpp>
+#include <gum/video/surface.hpp>
+#include <cstdint>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -59,6 +63,94 @@ template<typename T>
 struct is_valid_renderer : std::integral_constant<bool, std::is_same<T, SDL_Renderer*>::value || has_renderer<T>::value> {};
 } // detail
 
+// keeps a streaming texture locked for writing until destroyed. The rows of the
+// locked area are pitch bytes apart, which can be more than the width of a row
+struct texture_lock {
+private:
+    SDL_Texture* tex = nullptr;
+    void* pixels_ = nullptr;
+    int pitch_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+public:
+    texture_lock() = default;
+
+    // locks the whole texture if area is nullptr
+    texture_lock(SDL_Texture* texture, const SDL_Rect* area) {
+        if(area != nullptr) {
+            width_ = area->w;
+            height_ = area->h;
+        }
+        else if(SDL_QueryTexture(texture, nullptr, nullptr, &width_, &height_) != 0) {
+            GUM_ERROR_HANDLER_VOID();
+        }
+
+        if(SDL_LockTexture(texture, area, &pixels_, &pitch_) != 0) {
+            GUM_ERROR_HANDLER_VOID();
+        }
+        tex = texture;
+    }
+
+    texture_lock(const texture_lock&) = delete;
+    texture_lock& operator=(const texture_lock&) = delete;
+
+    texture_lock(texture_lock&& other) noexcept:
+        tex(other.tex), pixels_(other.pixels_), pitch_(other.pitch_), width_(other.width_), height_(other.height_) {
+        other.tex = nullptr;
+    }
+
+    texture_lock& operator=(texture_lock&& other) noexcept {
+        if(this != &other) {
+            unlock();
+            tex = other.tex;
+            pixels_ = other.pixels_;
+            pitch_ = other.pitch_;
+            width_ = other.width_;
+            height_ = other.height_;
+            other.tex = nullptr;
+        }
+        return *this;
+    }
+
+    ~texture_lock() {
+        unlock();
+    }
+
+    // uploads the changes, the pixels can't be used afterwards
+    void unlock() noexcept {
+        if(tex != nullptr) {
+            SDL_UnlockTexture(tex);
+            tex = nullptr;
+        }
+    }
+
+    explicit operator bool() const noexcept {
+        return tex != nullptr;
+    }
+
+    void* data() const noexcept {
+        return pixels_;
+    }
+
+    int pitch() const noexcept {
+        return pitch_;
+    }
+
+    int width() const noexcept {
+        return width_;
+    }
+
+    int height() const noexcept {
+        return height_;
+    }
+
+    // the start of a row of the locked area
+    template<typename T = uint32_t>
+    T* row(int y) const noexcept {
+        return reinterpret_cast<T*>(static_cast<unsigned char*>(pixels_) + y * pitch_);
+    }
+};
+
 struct texture {
 private:
     std::unique_ptr<SDL_Texture, detail::texture_deleter> ptr;
@@ -66,8 +158,9 @@ public:
     texture() = default;
 
     template<typename Window>
-    texture(int width, int height, const Window& win, int access = SDL_TEXTUREACCESS_STATIC) {
-        create(width, height, win, access);
+    texture(int width, int height, const Window& win, int access = SDL_TEXTUREACCESS_STATIC,
+            uint32_t format = SDL_PIXELFORMAT_RGBA8888) {
+        create(width, height, win, access, format);
     }
 
     template<typename Window>
@@ -76,9 +169,20 @@ public:
     }
 
     template<typename Window>
-    void create(int width, int height, const Window& win, int access = SDL_TEXTUREACCESS_STATIC) {
+    texture(const surface& image, const Window& win) {
+        load_surface(image, win);
+    }
+
+    // takes ownership of a texture created elsewhere
+    explicit texture(SDL_Texture* tex) noexcept: ptr(tex) {}
+
+    // video frames can be uploaded as they are with SDL_PIXELFORMAT_IYUV or SDL_PIXELFORMAT_NV12,
+    // the renderer then converts them to RGB while drawing
+    template<typename Window>
+    void create(int width, int height, const Window& win, int access = SDL_TEXTUREACCESS_STATIC,
+                uint32_t format = SDL_PIXELFORMAT_RGBA8888) {
         static_assert(detail::is_valid_renderer<Window>::value, "Type must either be an sdl::window or SDL_Renderer*");
-        ptr.reset(SDL_CreateTexture(detail::renderer_trait::get(win), SDL_PIXELFORMAT_RGBA8888, access, width, height));
+        ptr.reset(SDL_CreateTexture(detail::renderer_trait::get(win), format, access, width, height));
         if(ptr == nullptr) {
             GUM_ERROR_HANDLER_VOID();
         }
@@ -105,14 +209,111 @@ public:
         }
     }
 
+    // loads an image from any SDL_RWops, e.g. one from asset_pack::rwops. The source
+    // is always closed
+    template<typename Window>
+    void load_rw(SDL_RWops* source, const Window& win) {
+        static_assert(detail::is_valid_renderer<Window>::value, "Type must either be an sdl::window or SDL_Renderer*");
+        if(source == nullptr) {
+            ptr.reset(nullptr);
+            GUM_ERROR_HANDLER_VOID();
+        }
+
+        #ifndef GUM_IMG_DISABLED
+        auto* surface = IMG_Load_RW(source, 1);
+        #else
+        auto* surface = SDL_LoadBMP_RW(source, 1);
+        #endif
+
+        if(surface == nullptr) {
+            GUM_ERROR_HANDLER_VOID();
+        }
+
+        ptr.reset(SDL_CreateTextureFromSurface(detail::renderer_trait::get(win), surface));
+        SDL_FreeSurface(surface);
+
+        if(ptr == nullptr) {
+            GUM_ERROR_HANDLER_VOID();
+        }
+    }
+
+    template<typename Window>
+    void load_surface(const surface& image, const Window& win) {
+        static_assert(detail::is_valid_renderer<Window>::value, "Type must either be an sdl::window or SDL_Renderer*");
+        ptr.reset(SDL_CreateTextureFromSurface(detail::renderer_trait::get(win), image.data()));
+        if(ptr == nullptr) {
+            GUM_ERROR_HANDLER_VOID();
+        }
+    }
+
     SDL_Texture* data() const noexcept {
         return ptr.get();
     }
 
+    // only textures created with SDL_TEXTUREACCESS_STREAMING can be locked
+    texture_lock lock() {
+        return texture_lock(ptr.get(), nullptr);
+    }
+
+    texture_lock lock(const rect& area) {
+        return texture_lock(ptr.get(), &area);
+    }
+
+    // pitch is the amount of bytes between the rows of pixels
+    void update(const void* pixels, int pitch) {
+        if(SDL_UpdateTexture(ptr.get(), nullptr, pixels, pitch) != 0) {
+            GUM_ERROR_HANDLER_VOID();
+        }
+    }
+
+    void update(const rect& area, const void* pixels, int pitch) {
+        if(SDL_UpdateTexture(ptr.get(), &area, pixels, pitch) != 0) {
+            GUM_ERROR_HANDLER_VOID();
+        }
+    }
+
+    // uploads the three planes of an IYUV or YV12 texture straight from the decoder,
+    // the U and V planes are half the width and height of the Y plane
+    void update_yuv(const uint8_t* y, int y_pitch, const uint8_t* u, int u_pitch, const uint8_t* v, int v_pitch) {
+        if(SDL_UpdateYUVTexture(ptr.get(), nullptr, y, y_pitch, u, u_pitch, v, v_pitch) != 0) {
+            GUM_ERROR_HANDLER_VOID();
+        }
+    }
+
+    void update_yuv(const rect& area, const uint8_t* y, int y_pitch, const uint8_t* u, int u_pitch,
+                    const uint8_t* v, int v_pitch) {
+        if(SDL_UpdateYUVTexture(ptr.get(), &area, y, y_pitch, u, u_pitch, v, v_pitch) != 0) {
+            GUM_ERROR_HANDLER_VOID();
+        }
+    }
+
+#if defined(GUM_HAS_UPDATE_NV_TEXTURE)
+    // uploads the Y plane and the interleaved UV plane of an NV12 or NV21 texture
+    void update_nv(const uint8_t* y, int y_pitch, const uint8_t* uv, int uv_pitch) {
+        if(SDL_UpdateNVTexture(ptr.get(), nullptr, y, y_pitch, uv, uv_pitch) != 0) {
+            GUM_ERROR_HANDLER_VOID();
+        }
+    }
+
+    void update_nv(const rect& area, const uint8_t* y, int y_pitch, const uint8_t* uv, int uv_pitch) {
+        if(SDL_UpdateNVTexture(ptr.get(), &area, y, y_pitch, uv, uv_pitch) != 0) {
+            GUM_ERROR_HANDLER_VOID();
+        }
+    }
+#endif // GUM_HAS_UPDATE_NV_TEXTURE
+
     explicit operator bool() const noexcept {
         return ptr.get() != nullptr;
     }
 
+    uint32_t format() const {
+        uint32_t result = SDL_PIXELFORMAT_UNKNOWN;
+        if(SDL_QueryTexture(ptr.get(), &result, nullptr, nullptr, nullptr) != 0) {
+            GUM_ERROR_HANDLER_NO_RET();
+        }
+        return result;
+    }
+
     SDL_Point size() const {
         SDL_Point result;
         if(SDL_QueryTexture(ptr.get(), nullptr, nullptr, &result.x, &result.y) != 0) {
@@ -0,0 +1,327 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_VIDEO_TEXTURE_CACHE_HPP
+#define GUM_VIDEO_TEXTURE_CACHE_HPP
+
+#include <gum/core/error.hpp>
+#include <gum/video/rect.hpp>
+#include <gum/video/texture.hpp>
+#include <gum/video/sprite.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sdl {
+namespace detail {
+// bytes of video memory a texture of this format and size roughly takes up
+inline std::size_t texture_bytes(uint32_t format, int width, int height) noexcept {
+    auto w = static_cast<std::size_t>(width);
+    auto h = static_cast<std::size_t>(height);
+    if(SDL_ISPIXELFORMAT_FOURCC(format)) {
+        switch(format) {
+        case SDL_PIXELFORMAT_YV12:
+        case SDL_PIXELFORMAT_IYUV:
+        case SDL_PIXELFORMAT_NV12:
+        case SDL_PIXELFORMAT_NV21:
+            // a full size Y plane and two quarter size chroma planes
+            return w * h + 2 * (((w + 1) / 2) * ((h + 1) / 2));
+        default:
+            return w * h * 2;
+        }
+    }
+    return w * h * SDL_BYTESPERPIXEL(format);
+}
+
+struct cache_entry {
+    std::string path;
+    sdl::texture tex;        // empty while evicted, the address never changes
+    std::size_t bytes = 0;
+    uint64_t last_used = 0;  // the frame it was last used in
+    int width = 0;
+    int height = 0;
+};
+} // detail
+
+struct texture_cache;
+
+// a shared reference to a texture owned by a texture_cache, optionally to a region of it
+struct texture_handle {
+private:
+    friend struct texture_cache;
+    std::shared_ptr<detail::cache_entry> entry;
+    texture_cache* cache = nullptr;
+    rect region;
+    bool whole = true;
+
+    texture_handle(std::shared_ptr<detail::cache_entry> entry, texture_cache* cache) noexcept:
+        entry(std::move(entry)), cache(cache) {}
+
+    texture_handle(std::shared_ptr<detail::cache_entry> entry, texture_cache* cache, const rect& region) noexcept:
+        entry(std::move(entry)), cache(cache), region(region), whole(false) {}
+public:
+    texture_handle() = default;
+
+    // marks the texture as used this frame, reloading it first if it was evicted.
+    // The texture is emptied once evicted, so anything drawing it has to call this
+    // every frame it is drawn. cached_sprite does this for you
+    const sdl::texture& get() const;
+
+    bool valid() const noexcept {
+        return entry != nullptr;
+    }
+
+    explicit operator bool() const noexcept {
+        return valid();
+    }
+
+    bool resident() const noexcept {
+        return entry && static_cast<bool>(entry->tex);
+    }
+
+    // the part of the texture this handle refers to
+    rect area() const noexcept {
+        if(!whole || !entry) {
+            return region;
+        }
+        return rect(0, 0, entry->width, entry->height);
+    }
+
+    const std::string& path() const noexcept {
+        static const std::string empty;
+        return entry ? entry->path : empty;
+    }
+
+    // bytes of video memory the whole texture takes up when resident
+    std::size_t bytes() const noexcept {
+        return entry ? entry->bytes : 0;
+    }
+
+    // the amount of handles sharing the texture
+    long use_count() const noexcept {
+        return entry ? entry.use_count() - 1 : 0;
+    }
+};
+
+// loads every file once and hands out shared handles to it. Once the estimated memory
+// of the resident textures goes over the budget, the least recently used ones are
+// unloaded and transparently loaded again by texture_handle::get. Textures used in
+// the current frame are never evicted since the renderer may still draw them
+struct texture_cache {
+private:
+    friend struct texture_handle;
+    std::unordered_map<std::string, std::shared_ptr<detail::cache_entry>> entries;
+    SDL_Renderer* render = nullptr;
+    std::size_t budget_ = std::numeric_limits<std::size_t>::max();
+    std::size_t resident_ = 0;
+    uint64_t frame = 1;
+
+    struct least_recent {
+        bool operator()(const detail::cache_entry* lhs, const detail::cache_entry* rhs) const noexcept {
+            return lhs->last_used < rhs->last_used;
+        }
+    };
+
+    bool load(detail::cache_entry& entry) {
+        entry.tex.load_file(entry.path, render);
+        if(!entry.tex) {
+            return false;
+        }
+
+        auto size = entry.tex.size();
+        entry.width = size.x;
+        entry.height = size.y;
+        entry.bytes = detail::texture_bytes(entry.tex.format(), size.x, size.y);
+        resident_ += entry.bytes;
+        return true;
+    }
+
+    void unload(detail::cache_entry& entry) noexcept {
+        entry.tex = sdl::texture();
+        resident_ -= entry.bytes;
+    }
+
+    const sdl::texture& use(detail::cache_entry& entry) {
+        entry.last_used = frame;
+        if(!entry.tex && load(entry)) {
+            evict(budget_);
+        }
+        return entry.tex;
+    }
+
+    std::shared_ptr<detail::cache_entry>& find_or_load(const std::string& path) {
+        auto&& entry = entries[path];
+        if(entry == nullptr) {
+            entry = std::make_shared<detail::cache_entry>();
+            entry->path = path;
+        }
+        use(*entry);
+        return entry;
+    }
+public:
+    template<typename Window>
+    explicit texture_cache(const Window& win, std::size_t budget = std::numeric_limits<std::size_t>::max()):
+        render(detail::renderer_trait::get(win)), budget_(budget) {
+        static_assert(detail::is_valid_renderer<Window>::value, "Type must either be an sdl::window or SDL_Renderer*");
+    }
+
+    texture_cache(const texture_cache&) = delete;
+    texture_cache& operator=(const texture_cache&) = delete;
+
+    // loading a path that is already cached returns another handle to the same texture.
+    // If the file can't be loaded the error handler is called and the handle isn't resident
+    texture_handle load(const std::string& path) {
+        return texture_handle(find_or_load(path), this);
+    }
+
+    // a handle to a region of the texture, e.g. a frame of a sprite sheet. Every region
+    // of the same file shares a single texture
+    texture_handle load(const std::string& path, const rect& region) {
+        return texture_handle(find_or_load(path), this, region);
+    }
+
+    // starts a new frame, textures only used in earlier frames can be evicted from now on
+    void next_frame() noexcept {
+        ++frame;
+    }
+
+    void budget(std::size_t bytes) {
+        budget_ = bytes;
+        evict(budget_);
+    }
+
+    std::size_t budget() const noexcept {
+        return budget_;
+    }
+
+    // estimated bytes of video memory taken up by the resident textures
+    std::size_t resident() const noexcept {
+        return resident_;
+    }
+
+    std::size_t size() const noexcept {
+        return entries.size();
+    }
+
+    bool empty() const noexcept {
+        return entries.empty();
+    }
+
+    // unloads least recently used textures not used this frame until at most
+    // the given amount of bytes is resident. Textures without handles are forgotten
+    void evict(std::size_t bytes) {
+        if(resident_ <= bytes) {
+            return;
+        }
+
+        std::vector<detail::cache_entry*> candidates;
+        for(auto&& p : entries) {
+            auto&& entry = *p.second;
+            if(entry.tex && entry.last_used < frame) {
+                candidates.push_back(&entry);
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), least_recent());
+        for(auto&& entry : candidates) {
+            if(resident_ <= bytes) {
+                break;
+            }
+            unload(*entry);
+        }
+        release();
+    }
+
+    // forgets the evicted textures that no handle refers to anymore, resident
+    // ones are kept around in case they're loaded again
+    void release() {
+        for(auto it = entries.begin(); it != entries.end();) {
+            if(it->second.use_count() == 1 && !it->second->tex) {
+                it = entries.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    // unloads every texture not used this frame, handles still reload them when used
+    void clear() {
+        evict(0);
+    }
+};
+
+inline const sdl::texture& texture_handle::get() const {
+    if(entry == nullptr) {
+        static const sdl::texture empty;
+        return empty;
+    }
+    return cache->use(*entry);
+}
+
+// a sprite that keeps its texture_handle and marks it as used whenever it is drawn or
+// recorded, so the cache never evicts a texture out from under it
+struct cached_sprite : public sprite {
+private:
+    texture_handle handle_;
+public:
+    cached_sprite() = default;
+    cached_sprite(const texture_handle& handle): sprite(handle.get(), handle.area()), handle_(handle) {}
+
+    const texture_handle& handle() const noexcept {
+        return handle_;
+    }
+
+    void handle(const texture_handle& handle) {
+        texture(handle.get(), false);
+        subtexture(handle.area());
+        handle_ = handle;
+    }
+
+    void draw(SDL_Renderer* render) const {
+        render_state state(render);
+        draw(state);
+    }
+
+    void draw(render_state& state) const {
+        if(handle_) {
+            handle_.get();
+        }
+        sprite::draw(state);
+    }
+
+    void record(command_buffer& buffer) const {
+        record(buffer, layer(), depth());
+    }
+
+    void record(command_buffer& buffer, uint8_t layer, uint16_t depth = 0) const {
+        if(handle_) {
+            handle_.get();
+        }
+        sprite::record(buffer, layer, depth);
+    }
+};
+} // sdl
+
+#endif // GUM_VIDEO_TEXTURE_CACHE_HPP
@@ -21,6 +21,7 @@
 #define GUM_VIDEO_VECTOR_HPP
 
 #include <gum/core/config.hpp>
+#include <gum/detail/float_types.hpp>
 #include <cmath>
 
 namespace sdl {
@@ -146,6 +147,146 @@ inline double angle_between(const vector& from, const vector& to) noexcept {
 inline double direction(const vector& from, const vector& to) noexcept {
     return std::atan2(to.y - from.y, to.x - from.x);
 }
+// a vector with floating point coordinates for sub-pixel positions,
+// layout compatible with SDL_FPoint
+struct vectorf : detail::fpoint {
+    constexpr vectorf() noexcept: detail::fpoint{0.0f, 0.0f} {}
+    constexpr vectorf(float x, float y) noexcept: detail::fpoint{x, y} {}
+    constexpr explicit vectorf(const vector& v) noexcept: detail::fpoint{static_cast<float>(v.x), static_cast<float>(v.y)} {}
+
+    constexpr float length_squared() const noexcept {
+        return (x * x) + (y * y);
+    }
+
+    float length() const noexcept {
+        return std::sqrt(length_squared());
+    }
+
+    void normalise() noexcept {
+        auto len = length();
+        if(len != 0.0f) {
+            x /= len;
+            y /= len;
+        }
+    }
+
+    vectorf normalised() const noexcept {
+        vectorf result = { x, y };
+        result.normalise();
+        return result;
+    }
+
+    // rounded to the nearest integer
+    vector rounded() const noexcept {
+        return { static_cast<int>(std::lround(x)), static_cast<int>(std::lround(y)) };
+    }
+
+    vectorf& operator+=(const vectorf& rhs) noexcept {
+        x += rhs.x;
+        y += rhs.y;
+        return *this;
+    }
+
+    vectorf& operator-=(const vectorf& rhs) noexcept {
+        x -= rhs.x;
+        y -= rhs.y;
+        return *this;
+    }
+
+    vectorf& operator/=(const vectorf& rhs) noexcept {
+        x /= rhs.x;
+        y /= rhs.y;
+        return *this;
+    }
+
+    vectorf& operator*=(const vectorf& rhs) noexcept {
+        x *= rhs.x;
+        y *= rhs.y;
+        return *this;
+    }
+
+    vectorf& operator*=(float scalar) noexcept {
+        x *= scalar;
+        y *= scalar;
+        return *this;
+    }
+
+    vectorf& operator/=(float scalar) noexcept {
+        x /= scalar;
+        y /= scalar;
+        return *this;
+    }
+};
+
+constexpr vectorf operator+(const vectorf& lhs, const vectorf& rhs) noexcept {
+    return { lhs.x + rhs.x, lhs.y + rhs.y };
+}
+
+constexpr vectorf operator-(const vectorf& lhs, const vectorf& rhs) noexcept {
+    return { lhs.x - rhs.x, lhs.y - rhs.y };
+}
+
+constexpr vectorf operator*(const vectorf& lhs, const vectorf& rhs) noexcept {
+    return { lhs.x * rhs.x, lhs.y * rhs.y };
+}
+
+constexpr vectorf operator*(const vectorf& lhs, float scalar) noexcept {
+    return { lhs.x * scalar, lhs.y * scalar };
+}
+
+constexpr vectorf operator*(float scalar, const vectorf& rhs) noexcept {
+    return { rhs.x * scalar, rhs.y * scalar };
+}
+
+constexpr vectorf operator/(const vectorf& lhs, const vectorf& rhs) noexcept {
+    return { lhs.x / rhs.x, lhs.y / rhs.y };
+}
+
+constexpr vectorf operator/(const vectorf& lhs, float scalar) noexcept {
+    return { lhs.x / scalar, lhs.y / scalar };
+}
+
+constexpr vectorf operator-(const vectorf& unary) noexcept {
+    return { -unary.x, -unary.y };
+}
+
+constexpr bool operator==(const vectorf& lhs, const vectorf& rhs) noexcept {
+    return lhs.x == rhs.x && lhs.y == rhs.y;
+}
+
+constexpr bool operator!=(const vectorf& lhs, const vectorf& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+constexpr float dot(const vectorf& lhs, const vectorf& rhs) noexcept {
+    return (lhs.x * rhs.x) + (lhs.y * rhs.y);
+}
+
+constexpr float determinant(const vectorf& lhs, const vectorf& rhs) noexcept {
+    return (lhs.x * rhs.y) - (rhs.x * lhs.y);
+}
+
+constexpr vectorf lerp(const vectorf& from, const vectorf& to, float t) noexcept {
+    return { from.x + (to.x - from.x) * t, from.y + (to.y - from.y) * t };
+}
+
+inline float distance_squared(const vectorf& from, const vectorf& to) noexcept {
+    float dx = from.x - to.x;
+    float dy = from.y - to.y;
+    return (dx * dx) + (dy * dy);
+}
+
+inline float distance(const vectorf& from, const vectorf& to) noexcept {
+    return std::sqrt(distance_squared(from, to));
+}
+
+inline float angle_between(const vectorf& from, const vectorf& to) noexcept {
+    return std::acos(dot(from, to) / (from.length() * to.length()));
+}
+
+inline float direction(const vectorf& from, const vectorf& to) noexcept {
+    return std::atan2(to.y - from.y, to.x - from.x);
+}
 } // sdl
 
 #endif // GUM_VIDEO_VECTOR_HPP
@@ -0,0 +1,327 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_VIDEO_VECTOR_ARRAY_HPP
+#define GUM_VIDEO_VECTOR_ARRAY_HPP
+
+#include <gum/detail/vector_kernels.hpp>
+#include <gum/platform/thread_pool.hpp>
+#include <gum/video/vector.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sdl {
+// floating point vectors stored as separate arrays of x and y so that
+// positions, velocities and the like can be updated many at a time.
+// The arrays are padded with zero vectors to a multiple of 8.
+struct vector_array {
+private:
+    using storage = std::vector<float, detail::aligned_allocator<float, 32>>;
+    storage xs;
+    storage ys;
+    std::size_t count = 0;
+
+    static std::size_t padded(std::size_t n) noexcept {
+        return (n + 7) & ~static_cast<std::size_t>(7);
+    }
+
+    // runs full blocks of 8 through the best kernels and the rest through
+    // the scalar ones so the padding is never written to
+    template<typename Function>
+    static void split(std::size_t first, std::size_t last, const Function& f) {
+        auto middle = first + ((last - first) & ~static_cast<std::size_t>(7));
+        if(first != middle) {
+            f(detail::vector_kernels(), first, middle);
+        }
+
+        if(middle != last) {
+            f(detail::scalar_vector_kernel_table(), middle, last);
+        }
+    }
+
+    // splits [0, n) into chunks of whole 64 vector blocks so every
+    // thread writes to its own words of a mask
+    template<typename Function>
+    static void split(thread_pool& pool, std::size_t n, const Function& f) {
+        pool.parallel_for((n + 63) / 64, [&f, n](std::size_t first, std::size_t last, std::size_t) {
+            split(first * 64, std::min(last * 64, n), f);
+        });
+    }
+
+    static void prepare(std::vector<uint64_t>& mask, std::size_t n) {
+        mask.assign((n + 63) / 64, 0);
+    }
+public:
+    vector_array() = default;
+
+    explicit vector_array(std::size_t n) {
+        resize(n);
+    }
+
+    void reserve(std::size_t n) {
+        xs.reserve(padded(n));
+        ys.reserve(padded(n));
+    }
+
+    // new vectors are zero
+    void resize(std::size_t n) {
+        if(n < count) {
+            std::fill(xs.begin() + n, xs.begin() + count, 0.f);
+            std::fill(ys.begin() + n, ys.begin() + count, 0.f);
+        }
+
+        xs.resize(padded(n));
+        ys.resize(padded(n));
+        count = n;
+    }
+
+    void push_back(float x, float y) {
+        if(count == xs.size()) {
+            xs.resize(count + 8);
+            ys.resize(count + 8);
+        }
+
+        xs[count] = x;
+        ys[count] = y;
+        ++count;
+    }
+
+    void push_back(const vector& v) {
+        push_back(static_cast<float>(v.x), static_cast<float>(v.y));
+    }
+
+    void set(std::size_t index, float x, float y) noexcept {
+        xs[index] = x;
+        ys[index] = y;
+    }
+
+    detail::fpoint operator[](std::size_t index) const noexcept {
+        return { xs[index], ys[index] };
+    }
+
+    void clear() noexcept {
+        xs.clear();
+        ys.clear();
+        count = 0;
+    }
+
+    std::size_t size() const noexcept {
+        return count;
+    }
+
+    bool empty() const noexcept {
+        return count == 0;
+    }
+
+    float* x() noexcept {
+        return xs.data();
+    }
+
+    const float* x() const noexcept {
+        return xs.data();
+    }
+
+    float* y() noexcept {
+        return ys.data();
+    }
+
+    const float* y() const noexcept {
+        return ys.data();
+    }
+
+    // replaces the contents with the positions of a range of sprites
+    // or anything else with a positionf() getter
+    template<typename Iterator>
+    void assign_positions(Iterator first, Iterator last) {
+        clear();
+        for(; first != last; ++first) {
+            auto&& pos = first->positionf();
+            push_back(pos.x, pos.y);
+        }
+    }
+
+    // writes the vectors back through position(vectorf), starting at first
+    template<typename Iterator>
+    void write_positions(Iterator first) const {
+        for(std::size_t i = 0; i < count; ++i, ++first) {
+            first->position(vectorf(xs[i], ys[i]));
+        }
+    }
+
+    // the operations taking another array work on the shorter of the two
+    void add(const vector_array& other) noexcept {
+        auto n = std::min(count, other.count);
+        split(0, n, [this, &other](const detail::vector_kernel_table& k, std::size_t first, std::size_t last) {
+            k.add(xs.data(), ys.data(), other.xs.data(), other.ys.data(), first, last);
+        });
+    }
+
+    void add(thread_pool& pool, const vector_array& other) {
+        auto n = std::min(count, other.count);
+        split(pool, n, [this, &other](const detail::vector_kernel_table& k, std::size_t first, std::size_t last) {
+            k.add(xs.data(), ys.data(), other.xs.data(), other.ys.data(), first, last);
+        });
+    }
+
+    void add(float dx, float dy) noexcept {
+        split(0, count, [this, dx, dy](const detail::vector_kernel_table& k, std::size_t first, std::size_t last) {
+            k.translate(xs.data(), ys.data(), dx, dy, first, last);
+        });
+    }
+
+    void add(thread_pool& pool, float dx, float dy) {
+        split(pool, count, [this, dx, dy](const detail::vector_kernel_table& k, std::size_t first, std::size_t last) {
+            k.translate(xs.data(), ys.data(), dx, dy, first, last);
+        });
+    }
+
+    void scale(float sx, float sy) noexcept {
+        split(0, count, [this, sx, sy](const detail::vector_kernel_table& k, std::size_t first, std::size_t last) {
+            k.scale(xs.data(), ys.data(), sx, sy, first, last);
+        });
+    }
+
+    void scale(float s) noexcept {
+        scale(s, s);
+    }
+
+    void scale(thread_pool& pool, float sx, float sy) {
+        split(pool, count, [this, sx, sy](const detail::vector_kernel_table& k, std::size_t first, std::size_t last) {
+            k.scale(xs.data(), ys.data(), sx, sy, first, last);
+        });
+    }
+
+    void scale(thread_pool& pool, float s) {
+        scale(pool, s, s);
+    }
+
+    // this += velocity * dt
+    void multiply_add(const vector_array& velocity, float dt) noexcept {
+        auto n = std::min(count, velocity.count);
+        split(0, n, [this, &velocity, dt](const detail::vector_kernel_table& k, std::size_t first, std::size_t last) {
+            k.multiply_add(xs.data(), ys.data(), velocity.xs.data(), velocity.ys.data(), dt, first, last);
+        });
+    }
+
+    void multiply_add(thread_pool& pool, const vector_array& velocity, float dt) {
+        auto n = std::min(count, velocity.count);
+        split(pool, n, [this, &velocity, dt](const detail::vector_kernel_table& k, std::size_t first, std::size_t last) {
+            k.multiply_add(xs.data(), ys.data(), velocity.xs.data(), velocity.ys.data(), dt, first, last);
+        });
+    }
+
+    // out[i] is the dot product of the ith vectors of both arrays
+    void dot(const vector_array& other, std::vector<float>& out) const {
+        auto n = std::min(count, other.count);
+        out.resize(n);
+        auto result = out.data();
+        split(0, n, [this, &other, result](const detail::vector_kernel_table& k, std::size_t first, std::size_t last) {
+            k.dot(xs.data(), ys.data(), other.xs.data(), other.ys.data(), result, first, last);
+        });
+    }
+
+    void dot(thread_pool& pool, const vector_array& other, std::vector<float>& out) const {
+        auto n = std::min(count, other.count);
+        out.resize(n);
+        auto result = out.data();
+        split(pool, n, [this, &other, result](const detail::vector_kernel_table& k, std::size_t first, std::size_t last) {
+            k.dot(xs.data(), ys.data(), other.xs.data(), other.ys.data(), result, first, last);
+        });
+    }
+
+    // out[i] is the squared distance from the ith vector to (x, y)
+    void distance_squared(float x, float y, std::vector<float>& out) const {
+        out.resize(count);
+        auto result = out.data();
+        split(0, count, [this, x, y, result](const detail::vector_kernel_table& k, std::size_t first, std::size_t last) {
+            k.distance_squared(xs.data(), ys.data(), x, y, result, first, last);
+        });
+    }
+
+    void distance_squared(thread_pool& pool, float x, float y, std::vector<float>& out) const {
+        out.resize(count);
+        auto result = out.data();
+        split(pool, count, [this, x, y, result](const detail::vector_kernel_table& k, std::size_t first, std::size_t last) {
+            k.distance_squared(xs.data(), ys.data(), x, y, result, first, last);
+        });
+    }
+
+    // keeps every vector inside the rectangle, edges included
+    void clamp(const SDL_Rect& area) noexcept {
+        float x1 = static_cast<float>(area.x);
+        float y1 = static_cast<float>(area.y);
+        float x2 = static_cast<float>(area.x + area.w);
+        float y2 = static_cast<float>(area.y + area.h);
+        split(0, count, [this, x1, y1, x2, y2](const detail::vector_kernel_table& k, std::size_t first, std::size_t last) {
+            k.clamp(xs.data(), ys.data(), x1, y1, x2, y2, first, last);
+        });
+    }
+
+    void clamp(thread_pool& pool, const SDL_Rect& area) {
+        float x1 = static_cast<float>(area.x);
+        float y1 = static_cast<float>(area.y);
+        float x2 = static_cast<float>(area.x + area.w);
+        float y2 = static_cast<float>(area.y + area.h);
+        split(pool, count, [this, x1, y1, x2, y2](const detail::vector_kernel_table& k, std::size_t first, std::size_t last) {
+            k.clamp(xs.data(), ys.data(), x1, y1, x2, y2, first, last);
+        });
+    }
+
+    // sets bit i of mask when the ith vector is closer than radius to (x, y)
+    void within(float x, float y, float radius, std::vector<uint64_t>& mask) const {
+        prepare(mask, count);
+        auto bits = mask.data();
+        auto limit = radius * radius;
+        split(0, count, [this, x, y, limit, bits](const detail::vector_kernel_table& k, std::size_t first, std::size_t last) {
+            k.within(xs.data(), ys.data(), x, y, limit, bits, first, last);
+        });
+    }
+
+    void within(thread_pool& pool, float x, float y, float radius, std::vector<uint64_t>& mask) const {
+        prepare(mask, count);
+        auto bits = mask.data();
+        auto limit = radius * radius;
+        split(pool, count, [this, x, y, limit, bits](const detail::vector_kernel_table& k, std::size_t first, std::size_t last) {
+            k.within(xs.data(), ys.data(), x, y, limit, bits, first, last);
+        });
+    }
+
+    // sets bit i of mask when the ith vector is shorter than length
+    void shorter_than(float length, std::vector<uint64_t>& mask) const {
+        within(0.f, 0.f, length, mask);
+    }
+
+    void shorter_than(thread_pool& pool, float length, std::vector<uint64_t>& mask) const {
+        within(pool, 0.f, 0.f, length, mask);
+    }
+
+    // collects the indices of the vectors shorter than length
+    void shorter_than(float length, std::vector<uint32_t>& indices, std::vector<uint64_t>& scratch) const {
+        shorter_than(length, scratch);
+        indices.clear();
+        detail::for_each_bit(scratch.data(), scratch.size(), [&indices](std::size_t i) {
+            indices.push_back(static_cast<uint32_t>(i));
+        });
+    }
+};
+} // sdl
+
+#endif // GUM_VIDEO_VECTOR_ARRAY_HPP
@@ -0,0 +1,168 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+#ifndef GUM_VIDEO_VIEW_HPP
+#define GUM_VIDEO_VIEW_HPP
+
+#include <gum/detail/type_traits.hpp>
+#include <gum/video/rect.hpp>
+#include <gum/video/render_state.hpp>
+#include <gum/video/vector.hpp>
+#include <cmath>
+#include <type_traits>
+
+namespace sdl {
+// a camera looking at an area of the world and showing it in an area of the screen
+struct view {
+private:
+    rect port;       // where on the screen the world is shown
+    vector pos;      // the world position shown at the top left of the viewport
+    float zoom_ = 1.0f;
+
+    template<typename Drawable>
+    bool visible_impl(const Drawable& drawable, std::true_type) const {
+        return visible(drawable.bounds());
+    }
+
+    template<typename Drawable>
+    bool visible_impl(const Drawable&, std::false_type) const noexcept {
+        return true;
+    }
+public:
+    view() noexcept = default;
+    view(int width, int height) noexcept: port(0, 0, width, height) {}
+    explicit view(const rect& viewport) noexcept: port(viewport) {}
+
+    void viewport(const rect& area) noexcept {
+        port = area;
+    }
+
+    rect viewport() const noexcept {
+        return port;
+    }
+
+    void position(int x, int y) noexcept {
+        pos.x = x;
+        pos.y = y;
+    }
+
+    void position(const vector& p) noexcept {
+        pos = p;
+    }
+
+    vector position() const noexcept {
+        return pos;
+    }
+
+    void move(int x, int y) noexcept {
+        pos.x += x;
+        pos.y += y;
+    }
+
+    void move(const vector& amount) noexcept {
+        move(amount.x, amount.y);
+    }
+
+    // positions the view so that the world position is in the middle of the viewport
+    void center(int x, int y) noexcept {
+        auto&& visible = size();
+        pos.x = x - visible.x / 2;
+        pos.y = y - visible.y / 2;
+    }
+
+    void center(const vector& p) noexcept {
+        center(p.x, p.y);
+    }
+
+    vector center() const noexcept {
+        auto&& visible = size();
+        return { pos.x + visible.x / 2, pos.y + visible.y / 2 };
+    }
+
+    // values above 1 magnify, values below 1 show more of the world
+    void zoom(float factor) noexcept {
+        zoom_ = factor > 0.0f ? factor : zoom_;
+    }
+
+    float zoom() const noexcept {
+        return zoom_;
+    }
+
+    // the size of the world area visible
+    vector size() const noexcept {
+        return { static_cast<int>(std::ceil(port.w / zoom_)), static_cast<int>(std::ceil(port.h / zoom_)) };
+    }
+
+    // the world area visible
+    rect area() const noexcept {
+        auto&& visible = size();
+        return { pos.x, pos.y, visible.x, visible.y };
+    }
+
+    bool visible(const SDL_Rect& bounds) const noexcept {
+        auto&& visible = size();
+        return bounds.w > 0 && bounds.h > 0 &&
+               bounds.x < pos.x + visible.x && pos.x < bounds.x + bounds.w &&
+               bounds.y < pos.y + visible.y && pos.y < bounds.y + bounds.h;
+    }
+
+    // types without a bounds member function are always visible
+    template<typename Drawable, typename std::enable_if<!std::is_convertible<Drawable, SDL_Rect>::value, int>::type = 0>
+    bool visible(const Drawable& drawable) const {
+        return visible_impl(drawable, has_bounds<Drawable>());
+    }
+
+    vector to_world(int x, int y) const noexcept {
+        return { pos.x + static_cast<int>(std::floor((x - port.x) / zoom_)),
+                 pos.y + static_cast<int>(std::floor((y - port.y) / zoom_)) };
+    }
+
+    vector to_world(const vector& screen) const noexcept {
+        return to_world(screen.x, screen.y);
+    }
+
+    // the world area covering a screen area, rounded outwards
+    rect to_world(const rect& screen) const noexcept {
+        auto left = pos.x + static_cast<int>(std::floor((screen.x - port.x) / zoom_));
+        auto top = pos.y + static_cast<int>(std::floor((screen.y - port.y) / zoom_));
+        auto right = pos.x + static_cast<int>(std::ceil((screen.x + screen.w - port.x) / zoom_));
+        auto bottom = pos.y + static_cast<int>(std::ceil((screen.y + screen.h - port.y) / zoom_));
+        return { left, top, right - left, bottom - top };
+    }
+
+    vector to_screen(int x, int y) const noexcept {
+        return { port.x + static_cast<int>(std::floor((x - pos.x) * zoom_)),
+                 port.y + static_cast<int>(std::floor((y - pos.y) * zoom_)) };
+    }
+
+    vector to_screen(const vector& world) const noexcept {
+        return to_screen(world.x, world.y);
+    }
+
+    void apply(render_state& state) const noexcept {
+        // SDL multiplies the viewport by the scale in effect when it's set
+        state.scale(1.0f, 1.0f);
+        state.viewport(port);
+        state.scale(zoom_, zoom_);
+        state.offset(-pos.x, -pos.y);
+    }
+};
+} // sdl
+
+#endif // GUM_VIDEO_VIEW_HPP
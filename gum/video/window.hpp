@@ -24,9 +24,17 @@
 #include <gum/detail/type_traits.hpp>
 #include <gum/video/vector.hpp>
 #include <gum/video/colour.hpp>
+#include <gum/video/command_buffer.hpp>
+#include <gum/video/render_state.hpp>
+#include <gum/video/dirty_region.hpp>
+#include <gum/video/draw_list.hpp>
+#include <gum/video/texture.hpp>
+#include <gum/video/view.hpp>
+#include <cmath>
 #include <memory>
 #include <string>
 #include <cstdint>
+#include <type_traits>
 
 namespace sdl {
 struct window_deleter {
@@ -54,6 +62,223 @@ struct window {
 private:
     std::unique_ptr<SDL_Window, window_deleter> ptr;
     std::unique_ptr<SDL_Renderer, renderer_deleter> render;
+    render_state cache;
+    command_buffer commands_;
+    dirty_region regions;
+    std::unique_ptr<SDL_Texture, detail::texture_deleter> canvas; // keeps the frame around between presents
+    bool deferred_ = false;
+    bool dirty_ = false;
+    bool window_surface = false; // the software renderer draws straight into the window surface
+    sdl::view camera;
+    bool custom_view = false;
+    vectorf screen_scale = { 1.0f, 1.0f }; // the scale in effect outside of a view
+
+    template<typename Drawable>
+    void draw_impl(Drawable& drawable, std::true_type) {
+        drawable.draw(cache);
+    }
+
+    template<typename Drawable>
+    void draw_impl(Drawable& drawable, std::false_type) {
+        drawable.draw(render.get());
+        // the drawable could have changed anything
+        cache.invalidate();
+    }
+
+    template<typename Drawable>
+    bool overlaps(const Drawable& drawable, const rect& area, std::true_type) const {
+        return area.intersects(drawable.bounds());
+    }
+
+    template<typename Drawable>
+    bool overlaps(const Drawable&, const rect&, std::false_type) const noexcept {
+        return true;
+    }
+
+    // only drawables taking a render_state go through the view, the others
+    // have no way of applying its offset so they always draw in screen coordinates
+    template<typename Drawable>
+    bool in_view() const noexcept {
+        return custom_view && is_state_drawable<Drawable>::value;
+    }
+
+    // dirty rects are in screen coordinates, this is the part of one
+    // in the coordinates the drawable uses
+    rect local_area(const rect& area, bool through_view) const noexcept {
+        if(!through_view) {
+            return area;
+        }
+
+        auto shown = area.intersection(camera.viewport());
+        if(shown.empty()) {
+            return rect();
+        }
+        return camera.to_world(shown);
+    }
+
+    // the clip rect is relative to the viewport and scaled by SDL, but the
+    // view's offset is only known to gum so it has to be applied here
+    rect clip_area(const rect& local, bool through_view) const noexcept {
+        if(!through_view) {
+            return local;
+        }
+        auto moved = cache.translate(local);
+        return { moved.x, moved.y, moved.w, moved.h };
+    }
+
+    // undoes the view so that drawing happens in screen coordinates
+    void screen_space() {
+        cache.scale(1.0f, 1.0f);
+        cache.viewport(output_area());
+        cache.offset(0, 0);
+    }
+
+    template<typename Drawable>
+    void draw_clipped(Drawable& drawable) {
+        bool through_view = in_view<Drawable>();
+        bool outside_view = custom_view && !through_view;
+        if(!dirty_) {
+            if(outside_view) {
+                screen_space();
+            }
+            draw_impl(drawable, is_state_drawable<Drawable>());
+        }
+        else {
+            // drawn once for every dirty rect it touches so nothing outside of them changes
+            for(auto&& area : regions) {
+                auto local = local_area(area, through_view);
+                if(overlaps(drawable, local, has_bounds<Drawable>())) {
+                    if(outside_view) {
+                        screen_space();
+                    }
+                    cache.clip(clip_area(local, through_view));
+                    draw_impl(drawable, is_state_drawable<Drawable>());
+                }
+            }
+        }
+
+        if(outside_view) {
+            camera.apply(cache);
+        }
+    }
+
+    // the size drawables see, which is the logical size rather than the size in
+    // pixels when SDL_RenderSetLogicalSize or a scale is used e.g. for high DPI
+    rect output_area() const noexcept {
+        rect result;
+        if(!custom_view) {
+            SDL_RenderGetLogicalSize(render.get(), &result.w, &result.h);
+            if(result.w > 0 && result.h > 0) {
+                return result;
+            }
+        }
+
+        SDL_GetRendererOutputSize(render.get(), &result.w, &result.h);
+        if(!custom_view && screen_scale.x > 0.0f && screen_scale.y > 0.0f) {
+            result.w = static_cast<int>(std::ceil(result.w / screen_scale.x));
+            result.h = static_cast<int>(std::ceil(result.h / screen_scale.y));
+        }
+        return result;
+    }
+
+    // makes sure the canvas matches the output size, redrawing everything if it had to be recreated
+    void prepare_canvas() {
+        auto area = output_area();
+        if(area != regions.bounds()) {
+            regions.bounds(area);
+            regions.add_all();
+            if(!window_surface) {
+                canvas.reset();
+            }
+        }
+
+        if(window_surface) {
+            return;
+        }
+
+        if(canvas == nullptr) {
+            SDL_RendererInfo info;
+            if(SDL_GetRendererInfo(render.get(), &info) == 0 && (info.flags & SDL_RENDERER_TARGETTEXTURE)) {
+                Uint32 format = SDL_PIXELFORMAT_RGBA8888;
+                if(info.num_texture_formats > 0) {
+                    format = info.texture_formats[0];
+                }
+                canvas.reset(SDL_CreateTexture(render.get(), format, SDL_TEXTUREACCESS_TARGET, area.w, area.h));
+            }
+            regions.add_all();
+        }
+
+        if(canvas == nullptr) {
+            // no way of keeping the previous frame so everything is redrawn
+            regions.add_all();
+            return;
+        }
+
+        cache.target(canvas.get());
+    }
+
+    // the keys are either empty, leaving the drawable to pick its own order, or a layer and depth
+    template<typename Drawable, typename... Keys>
+    void record_impl(Drawable& drawable, std::true_type, Keys... keys) {
+        drawable.record(commands_, keys...);
+    }
+
+    template<typename Drawable, typename... Keys>
+    void record_impl(Drawable& drawable, std::false_type, Keys...) {
+        // drawables that can't be recorded are drawn immediately after
+        // the commands recorded so far to keep the drawing order intact
+        flush();
+        draw_clipped(drawable);
+    }
+
+    template<typename Drawable>
+    bool visible(const Drawable& drawable, std::true_type) const {
+        if(!in_view<Drawable>()) {
+            return regions.intersects(drawable.bounds());
+        }
+
+        auto&& bounds = drawable.bounds();
+        for(auto&& area : regions) {
+            if(local_area(area, true).intersects(bounds)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template<typename Drawable>
+    bool visible(const Drawable&, std::false_type) const noexcept {
+        return !regions.empty();
+    }
+
+    struct list_drawer {
+        window& win;
+
+        template<typename Drawable>
+        void operator()(Drawable& drawable) const {
+            win.draw(drawable);
+        }
+    };
+
+    template<typename Drawable, typename... Keys>
+    void submit(Drawable& drawable, Keys... keys) {
+        static_assert(is_renderer_drawable<Drawable>::value || is_state_drawable<Drawable>::value,
+                      "Must provide a void draw(SDL_Renderer*) or void draw(sdl::render_state&) member function");
+        if(in_view<Drawable>() && !camera.visible(drawable)) {
+            return;
+        }
+
+        if(dirty_ && !visible(drawable, has_bounds<Drawable>())) {
+            return;
+        }
+
+        if(deferred_) {
+            record_impl(drawable, is_command_recordable<Drawable>(), keys...);
+        }
+        else {
+            draw_clipped(drawable);
+        }
+    }
 public:
     static const auto npos     = SDL_WINDOWPOS_UNDEFINED;
     static const auto centered = SDL_WINDOWPOS_CENTERED;
@@ -72,19 +297,22 @@ public:
     };
 
 
-    window(const std::string& title, const SDL_DisplayMode& display, uint32_t flag = 0):
-        window(title, display.w, display.h, flag) {}
+    window(const std::string& title, const SDL_DisplayMode& display, uint32_t flag = 0,
+           uint32_t renderer_flag = renderer::accelerated):
+        window(title, display.w, display.h, flag, renderer_flag) {}
 
-    window(const std::string& title, int width, int height, uint32_t flag = 0):
+    window(const std::string& title, int width, int height, uint32_t flag = 0,
+           uint32_t renderer_flag = renderer::accelerated):
         ptr(SDL_CreateWindow(title.c_str(), npos, npos, width, height, flag)) {
         if(ptr == nullptr) {
             GUM_ERROR_HANDLER_VOID();
         }
 
-        render.reset(SDL_CreateRenderer(ptr.get(), -1, renderer::accelerated));
+        render.reset(SDL_CreateRenderer(ptr.get(), -1, renderer_flag));
         if(render == nullptr) {
             GUM_ERROR_HANDLER_VOID();
         }
+        cache.renderer(render.get());
     }
 
     bool is_open() const noexcept {
@@ -92,8 +320,33 @@ public:
     }
 
     void clear(const colour& c = colour::black()) {
-        SDL_SetRenderDrawColor(render.get(), c.r, c.g, c.b, c.a);
-        SDL_RenderClear(render.get());
+        // anything recorded before clearing would be drawn over anyway
+        commands_.clear();
+        cache.draw_colour(c);
+        if(!dirty_) {
+            SDL_RenderClear(render.get());
+            return;
+        }
+
+        prepare_canvas();
+        if(!regions.empty()) {
+            // the dirty rects are in screen coordinates
+            if(custom_view) {
+                screen_space();
+            }
+
+            // clearing ignores the blend mode so filling has to as well
+            auto previous = cache.blend();
+            cache.blend(blend_mode::none);
+            cache.disable_clip();
+            SDL_RenderFillRects(render.get(), regions.data(), static_cast<int>(regions.size()));
+            cache.blend(previous);
+        }
+
+        if(custom_view) {
+            // switching to the canvas resets the viewport and scale
+            camera.apply(cache);
+        }
     }
 
     SDL_Window* data() const noexcept {
@@ -104,10 +357,159 @@ public:
         return render.get();
     }
 
+    render_state& state() noexcept {
+        return cache;
+    }
+
+    // draws go through the view from now on, drawables entirely outside of it are skipped
+    void view(const sdl::view& v) {
+        flush();
+        if(!custom_view && cache.target() == nullptr) {
+            screen_scale = cache.scale();
+        }
+        camera = v;
+        custom_view = true;
+        camera.apply(cache);
+    }
+
+    const sdl::view& view() const noexcept {
+        return camera;
+    }
+
+    // goes back to drawing in screen coordinates over the whole window
+    void reset_view() {
+        flush();
+        custom_view = false;
+        camera = sdl::view(output_area());
+        cache.offset(0, 0);
+        int width = 0;
+        int height = 0;
+        SDL_RenderGetLogicalSize(render.get(), &width, &height);
+        if(cache.target() != nullptr) {
+            // the canvas is always drawn to at its own size
+            cache.scale(1.0f, 1.0f);
+            cache.viewport(output_area());
+        }
+        else if(width > 0 && height > 0) {
+            // recomputes the viewport and scale SDL uses for the logical size
+            SDL_RenderSetLogicalSize(render.get(), width, height);
+            cache.invalidate();
+        }
+        else {
+            cache.scale(1.0f, 1.0f);
+            cache.viewport(output_area());
+            cache.scale(screen_scale.x, screen_scale.y);
+        }
+    }
+
+    command_buffer& commands() noexcept {
+        return commands_;
+    }
+
+    // deferred drawables are sorted by layer then depth instead of grouping equal textures
+    // within a layer, see command_buffer::depth_order
+    void depth_order(bool b) {
+        flush();
+        commands_.depth_order(b);
+    }
+
+    bool depth_order() const noexcept {
+        return commands_.depth_order();
+    }
+
+    void deferred(bool b) {
+        if(!b) {
+            flush();
+        }
+        deferred_ = b;
+    }
+
+    bool deferred() const noexcept {
+        return deferred_;
+    }
+
+    // only redraws and presents the areas marked through invalidate
+    void dirty(bool b) {
+        if(b == dirty_) {
+            return;
+        }
+
+        flush();
+        dirty_ = b;
+        regions.clear();
+        regions.bounds(rect());
+        canvas.reset();
+        cache.invalidate();
+        cache.target(nullptr);
+        cache.disable_clip();
+        window_surface = false;
+        if(b) {
+            if(!custom_view) {
+                screen_scale = cache.scale();
+            }
+            SDL_RendererInfo info;
+            window_surface = SDL_GetRendererInfo(render.get(), &info) == 0 && (info.flags & SDL_RENDERER_SOFTWARE);
+            regions.bounds(output_area());
+            regions.add_all();
+        }
+    }
+
+    bool dirty() const noexcept {
+        return dirty_;
+    }
+
+    void invalidate(const rect& area) {
+        if(dirty_) {
+            regions.add(area);
+        }
+    }
+
+    void invalidate() {
+        if(dirty_) {
+            regions.add_all();
+        }
+    }
+
+    const dirty_region& dirty_regions() const noexcept {
+        return regions;
+    }
+
+    // sorts and issues every command recorded so far
+    void flush() {
+        if(commands_.empty()) {
+            return;
+        }
+
+        if(!dirty_) {
+            commands_.replay(cache);
+            return;
+        }
+
+        // recorded drawables all take a render_state and go through the view
+        commands_.sort();
+        for(auto&& area : regions) {
+            cache.clip(clip_area(local_area(area, custom_view), custom_view));
+            commands_.execute(cache);
+        }
+        commands_.clear();
+    }
+
+    // recorded drawables such as sprites use their own layer and depth when deferred
     template<typename Drawable>
     void draw(Drawable& drawable) {
-        static_assert(is_renderer_drawable<Drawable>::value, "Must provide a void draw(SDL_Renderer*) member function");
-        drawable.draw(render.get());
+        submit(drawable);
+    }
+
+    template<typename Drawable>
+    void draw(Drawable& drawable, uint8_t layer, uint16_t depth = 0) {
+        submit(drawable, layer, depth);
+    }
+
+    // draws every drawable of the list one type at a time, each one as if
+    // passed on its own so they are culled and recorded individually
+    template<typename... Ts>
+    void draw(draw_list<Ts...>& list) {
+        list.for_each(list_drawer{ *this });
     }
 
     float brightness() const noexcept {
@@ -246,8 +648,39 @@ public:
         ptr.reset(nullptr);
     }
 
-    void display() noexcept {
-        SDL_RenderPresent(render.get());
+    void display() {
+        flush();
+        if(!dirty_) {
+            SDL_RenderPresent(render.get());
+            return;
+        }
+
+        // nothing changed so the last frame is still on screen. The window surface keeps it
+        // as is, the canvas is presented again so that vsync still paces the main loop
+        if(regions.empty() && (window_surface || canvas == nullptr)) {
+            return;
+        }
+
+        cache.disable_clip();
+        if(window_surface) {
+#if defined(GUM_HAS_RENDER_FLUSH)
+            SDL_RenderFlush(render.get());
+#endif
+            SDL_UpdateWindowSurfaceRects(ptr.get(), regions.data(), static_cast<int>(regions.size()));
+        }
+        else {
+            if(canvas != nullptr) {
+                // the window gets back the viewport and scale it had before drawing to
+                // the canvas, which could be the view's
+                cache.target(nullptr);
+                cache.scale(1.0f, 1.0f);
+                SDL_RenderSetViewport(render.get(), nullptr);
+                cache.invalidate();
+                SDL_RenderCopy(render.get(), canvas.get(), nullptr, nullptr);
+            }
+            SDL_RenderPresent(render.get());
+        }
+        regions.clear();
     }
 
     void swap_window() noexcept {
@@ -0,0 +1,74 @@
+# builds an asset pack that sdl::asset_pack can read
+
+import os, sys, struct
+import argparse
+
+# command line
+parser = argparse.ArgumentParser()
+parser.add_argument('--input', '-i', help='a directory or file to pack', metavar='<path>', action='append', required=True)
+parser.add_argument('--output', '-o', help='the pack to write to', metavar='<file>', action='store', required=True)
+parser.add_argument('--align', '-a', help='alignment of every file in bytes', metavar='<n>', type=int, default=16)
+args = parser.parse_args()
+
+# the layout, see gum/io/asset_pack.hpp
+magic = b'GUMP'
+version = 1
+header = struct.Struct('<4sIII')
+entry = struct.Struct('<QQQII')
+
+def fnv1a(data):
+    result = 14695981039346656037
+    for byte in bytearray(data):
+        result ^= byte
+        result = (result * 1099511628211) & 0xFFFFFFFFFFFFFFFF
+    return result
+
+def collect(paths):
+    result = {}
+    for path in paths:
+        if os.path.isfile(path):
+            result[os.path.basename(path).encode('utf-8')] = path
+            continue
+
+        for root, dirs, files in os.walk(path):
+            for filename in files:
+                full = os.path.join(root, filename)
+                name = os.path.relpath(full, path).replace(os.sep, '/')
+                result[name.encode('utf-8')] = full
+    return result
+
+def align(offset):
+    return (offset + args.align - 1) // args.align * args.align
+
+def build(files):
+    # names are sorted bytewise so the reader can binary search them
+    names = sorted(files)
+    name_table = b''.join(names)
+    offset = align(header.size + entry.size * len(names) + len(name_table))
+    index = []
+    contents = []
+    name_offset = 0
+    for name in names:
+        with open(files[name], 'rb') as f:
+            data = f.read()
+        index.append(entry.pack(offset, len(data), fnv1a(data), name_offset, len(name)))
+        contents.append((offset, data))
+        name_offset += len(name)
+        offset = align(offset + len(data))
+
+    result = bytearray(header.pack(magic, version, len(names), len(name_table)))
+    result += b''.join(index)
+    result += name_table
+    for position, data in contents:
+        result += b'\0' * (position - len(result))
+        result += data
+    return result
+
+if args.align < 1:
+    sys.exit('alignment must be at least 1')
+
+files = collect(args.input)
+with open(args.output, 'wb') as f:
+    f.write(build(files))
+
+print('packed {} files into {}'.format(len(files), args.output))
@@ -0,0 +1,168 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+// opens a pack made by pack_tool.py from tests/assets and checks every asset
+// against the file it was made from, then checks that broken indices are rejected
+
+#include <gum/io/asset_pack.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+int failures = 0;
+
+// in the order pack_tool.py sorts them, bytewise
+const char* const names[] = { "B.txt", "a.txt", "a/b.txt", "sprites/hero.bin" };
+
+void fail(const char* what, const std::string& name) {
+    ++failures;
+    std::printf("%s failed for '%s'\n", what, name.c_str());
+}
+
+std::vector<char> read_file(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void write_file(const std::string& filename, const std::vector<char>& contents) {
+    std::ofstream out(filename, std::ios::binary);
+    out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+}
+
+void check_asset(const sdl::asset_pack& pack, const std::string& name) {
+    auto expected = read_file(std::string(GUM_TEST_ASSETS) + "/" + name);
+    auto* entry = pack.find(name);
+    if(entry == nullptr || !pack.contains(name)) {
+        fail("find", name);
+        return;
+    }
+
+    if(std::string(entry->name, entry->name_size) != name || entry->size != expected.size() ||
+       std::memcmp(entry->data, expected.data(), expected.size()) != 0) {
+        fail("contents", name);
+    }
+
+    if(!pack.verify(*entry)) {
+        fail("verify", name);
+    }
+
+    // read in small pieces so that the SDL_RWops has to keep its position
+    std::vector<char> contents;
+    auto* rw = pack.rwops(name);
+    char buffer[100];
+    std::size_t read = 0;
+    while((read = SDL_RWread(rw, buffer, 1, sizeof(buffer))) != 0) {
+        contents.insert(contents.end(), buffer, buffer + read);
+    }
+    SDL_RWclose(rw);
+    if(contents != expected) {
+        fail("rwops", name);
+    }
+}
+
+bool opens(const std::string& filename) {
+    sdl::asset_pack pack;
+    try {
+        return pack.open(filename);
+    }
+    catch(const sdl::error&) {
+        return false;
+    }
+}
+
+// the index starts after the 16 byte header and every entry is 32 bytes
+void check_broken_index(const std::vector<char>& original) {
+    auto broken = std::string(GUM_TEST_PACK) + ".broken";
+    auto swapped = original;
+    std::swap_ranges(swapped.begin() + 16, swapped.begin() + 48, swapped.begin() + 48);
+    write_file(broken, swapped);
+    if(opens(broken)) {
+        fail("rejecting an unsorted index", broken);
+    }
+
+    auto duplicated = original;
+    std::copy(duplicated.begin() + 16, duplicated.begin() + 48, duplicated.begin() + 48);
+    write_file(broken, duplicated);
+    if(opens(broken)) {
+        fail("rejecting duplicate names", broken);
+    }
+
+    auto truncated = original;
+    truncated.resize(40);
+    write_file(broken, truncated);
+    if(opens(broken)) {
+        fail("rejecting a truncated pack", broken);
+    }
+    std::remove(broken.c_str());
+}
+} // anonymous namespace
+
+int main() {
+    sdl::asset_pack pack(GUM_TEST_PACK);
+    auto count = sizeof(names) / sizeof(names[0]);
+    if(pack.size() != count) {
+        std::printf("expected %u assets but the pack has %u\n", static_cast<unsigned>(count),
+                    static_cast<unsigned>(pack.size()));
+        return 1;
+    }
+
+    for(std::size_t i = 0; i < count; ++i) {
+        if(std::string(pack.assets()[i].name, pack.assets()[i].name_size) != names[i]) {
+            fail("sorted index", names[i]);
+        }
+        check_asset(pack, names[i]);
+    }
+
+    for(auto&& missing : { "", "a", "a.tx", "a.txt0", "b.txt", "sprites/", "zzz" }) {
+        if(pack.find(missing) != nullptr) {
+            fail("finding nothing", missing);
+        }
+    }
+
+    if(!pack.verify()) {
+        fail("verify", GUM_TEST_PACK);
+    }
+
+    auto original = read_file(GUM_TEST_PACK);
+    auto corrupted = original;
+    corrupted.back() ^= 1;
+    auto copy = std::string(GUM_TEST_PACK) + ".corrupted";
+    write_file(copy, corrupted);
+    {
+        sdl::asset_pack damaged(copy);
+        if(damaged.verify()) {
+            fail("detecting corrupted contents", copy);
+        }
+    }
+    std::remove(copy.c_str());
+    check_broken_index(original);
+
+    if(failures != 0) {
+        std::printf("%d asset pack checks failed\n", failures);
+        return 1;
+    }
+
+    std::printf("%u assets round tripped through pack_tool.py\n", static_cast<unsigned>(count));
+    return 0;
+}
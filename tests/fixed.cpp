@@ -0,0 +1,204 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+// checks the fixed point arithmetic against 64-bit integer references, and the
+// square root and trigonometry against the standard library
+
+#include <gum/video/fixed.hpp>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+namespace {
+std::mt19937_64 rng(20160405);
+int failures = 0;
+const double pi = 3.14159265358979323846;
+
+int32_t random_raw() {
+    // small numbers come up often so that the results don't always overflow
+    auto bits = static_cast<uint32_t>(rng());
+    switch(rng() % 3) {
+    case 0:
+        return static_cast<int32_t>(static_cast<int16_t>(bits));
+    case 1:
+        return static_cast<int32_t>(bits >> 8) - (1 << 23);
+    default:
+        return static_cast<int32_t>(bits);
+    }
+}
+
+void fail(const char* what, int64_t a, int64_t b) {
+    if(++failures <= 20) {
+        std::printf("%s failed for %lld and %lld\n", what, static_cast<long long>(a), static_cast<long long>(b));
+    }
+}
+
+// two's complement wrap around of the reference result
+int32_t wrap(int64_t n) {
+    int64_t low = n & 0xffffffff;
+    return static_cast<int32_t>(low > INT32_MAX ? low - (int64_t(1) << 32) : low);
+}
+
+int64_t floor_divide(int64_t n, int64_t d) {
+    auto q = n / d;
+    return (n % d != 0 && (n < 0) != (d < 0)) ? q - 1 : q;
+}
+
+void check_arithmetic(int32_t a, int32_t b) {
+    auto x = sdl::fixed::from_raw(a);
+    auto y = sdl::fixed::from_raw(b);
+    if((x + y).raw() != wrap(int64_t(a) + b)) {
+        fail("addition", a, b);
+    }
+
+    if((x - y).raw() != wrap(int64_t(a) - b)) {
+        fail("subtraction", a, b);
+    }
+
+    if((-x).raw() != wrap(-int64_t(a))) {
+        fail("negation", a, b);
+    }
+
+    if((x * y).raw() != wrap(floor_divide(int64_t(a) * b, 65536))) {
+        fail("multiplication", a, b);
+    }
+
+    auto expected = b != 0 ? wrap(int64_t(a) * 65536 / b) : a > 0 ? INT32_MAX : a < 0 ? INT32_MIN : 0;
+    if((x / y).raw() != expected) {
+        fail("division", a, b);
+    }
+
+    // the compound assignments have to agree with the operators
+    auto z = x;
+    z += y;
+    z -= x;
+    z *= x;
+    z /= y;
+    if(z != (x + y - x) * x / y) {
+        fail("compound assignment", a, b);
+    }
+}
+
+void check_isqrt(uint64_t n) {
+    uint64_t root = sdl::detail::isqrt(n);
+    auto below = root * root <= n;
+    auto above = root == 0xffffffff || (root + 1) * (root + 1) > n;
+    if(!below || !above) {
+        fail("isqrt", static_cast<int64_t>(n >> 1), static_cast<int64_t>(root));
+    }
+}
+
+void check_tables() {
+    auto* sine = sdl::detail::sine_table();
+    for(int i = 0; i <= 256; ++i) {
+        auto expected = std::lround(std::sin(i * pi / 512) * 65536);
+        if(sine[i] != expected) {
+            fail("sine table", i, sine[i]);
+        }
+    }
+
+    auto* arctangent = sdl::detail::arctangent_table();
+    for(int i = 0; i <= 256; ++i) {
+        auto expected = std::lround(std::atan(i / 256.0) * 180 / pi * 65536);
+        if(arctangent[i] != expected) {
+            fail("arctangent table", i, arctangent[i]);
+        }
+    }
+}
+
+// the angle is reduced to a binary angle of 65536 steps a turn first, which is
+// where most of the error comes from
+void check_trigonometry(int32_t a, int32_t b) {
+    auto degrees = sdl::fixed::from_raw(a);
+    auto radians = degrees.to_double() * pi / 180;
+    if(std::fabs(sdl::sin(degrees).to_double() - std::sin(radians)) > 0.00012) {
+        fail("sin", a, sdl::sin(degrees).raw());
+    }
+
+    if(std::fabs(sdl::cos(degrees).to_double() - std::cos(radians)) > 0.00012) {
+        fail("cos", a, sdl::cos(degrees).raw());
+    }
+
+    if(a == 0 && b == 0) {
+        return;
+    }
+
+    auto y = sdl::fixed::from_raw(a);
+    auto x = sdl::fixed::from_raw(b);
+    auto result = sdl::atan2(y, x).to_double();
+    auto difference = std::fabs(result - std::atan2(y.to_double(), x.to_double()) * 180 / pi);
+    if(difference > 0.001) {
+        fail("atan2", a, b);
+    }
+}
+
+void check_conversions() {
+    if(sdl::fixed(1L) != sdl::fixed(1) || sdl::fixed(1u) != sdl::fixed(1) || sdl::fixed(-2LL) != sdl::fixed(-2) ||
+       sdl::fixed(static_cast<short>(3)) != sdl::fixed(3) || sdl::fixed(1.0f) != sdl::fixed(1)) {
+        fail("integer conversion", 1, 1);
+    }
+
+    if(sdl::fixed(32768).raw() != INT32_MIN || sdl::fixed(65537).raw() != 65536) {
+        fail("integer wrap around", 32768, 65537);
+    }
+
+    if(sdl::fixed(1.5).raw() != 98304 || sdl::fixed(-1.5).raw() != -98304 || sdl::fixed(0.00001).raw() != 1) {
+        fail("double conversion", 98304, -98304);
+    }
+
+    if(sdl::fixed(40000.0).raw() != INT32_MAX || sdl::fixed(-40000.0).raw() != INT32_MIN ||
+       sdl::fixed(1e300).raw() != INT32_MAX || sdl::fixed(std::nan("")).raw() != 0) {
+        fail("double saturation", INT32_MAX, INT32_MIN);
+    }
+}
+} // anonymous namespace
+
+int main() {
+    const int iterations = 1000000;
+    check_tables();
+    check_conversions();
+    for(uint64_t n = 0; n < 100000; ++n) {
+        check_isqrt(n);
+    }
+
+    const int32_t edges[] = { 0, 1, -1, 65536, -65536, INT32_MAX, INT32_MIN, INT32_MAX - 1, INT32_MIN + 1 };
+    for(auto a : edges) {
+        for(auto b : edges) {
+            check_arithmetic(a, b);
+        }
+        check_isqrt(static_cast<uint64_t>(a) * static_cast<uint64_t>(a));
+        check_isqrt(static_cast<uint64_t>(a) * static_cast<uint64_t>(a) - 1);
+    }
+
+    for(int i = 0; i < iterations; ++i) {
+        auto a = random_raw();
+        auto b = random_raw();
+        check_arithmetic(a, b);
+        check_isqrt(rng() >> (rng() % 64));
+        check_trigonometry(a, b);
+    }
+
+    if(failures != 0) {
+        std::printf("%d mismatches against the references\n", failures);
+        return 1;
+    }
+
+    std::printf("%d random cases matched the references\n", iterations);
+    return 0;
+}
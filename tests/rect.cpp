@@ -0,0 +1,181 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+// checks the inline rect algebra against the SDL functions it replaces
+// on random input, including empty and negative sized rectangles
+
+#include <gum/video/rect.hpp>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+std::mt19937 rng(20160405);
+int failures = 0;
+
+int random_int(int low, int high) {
+    return std::uniform_int_distribution<int>(low, high)(rng);
+}
+
+// small coordinates so that touching edges, single pixel rectangles and
+// degenerate lines come up often
+sdl::rect random_rect() {
+    return sdl::rect(random_int(-20, 20), random_int(-20, 20), random_int(-3, 20), random_int(-3, 20));
+}
+
+SDL_Point random_point() {
+    return SDL_Point{ random_int(-30, 30), random_int(-30, 30) };
+}
+
+bool same(const SDL_Rect& lhs, const SDL_Rect& rhs) {
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.w == rhs.w && lhs.h == rhs.h;
+}
+
+void fail(const char* what, const SDL_Rect& a, const SDL_Rect& b) {
+    if(++failures <= 20) {
+        std::printf("%s failed for (%d, %d, %d, %d) and (%d, %d, %d, %d)\n", what,
+                    a.x, a.y, a.w, a.h, b.x, b.y, b.w, b.h);
+    }
+}
+
+void check_intersects(const sdl::rect& a, const sdl::rect& b) {
+    if(a.intersects(b) != (SDL_HasIntersection(&a, &b) == SDL_TRUE)) {
+        fail("intersects", a, b);
+    }
+}
+
+void check_intersection(const sdl::rect& a, const sdl::rect& b) {
+    // SDL leaves the result alone for some inputs when there's no
+    // intersection, so only non-empty results are compared exactly
+    SDL_Rect expected = a;
+    auto hit = SDL_IntersectRect(&a, &b, &expected) == SDL_TRUE;
+    auto result = a.intersection(b);
+    if(hit == result.empty() || (hit && !same(result, expected))) {
+        fail("intersection", a, b);
+    }
+}
+
+void check_union(const sdl::rect& a, const sdl::rect& b) {
+    SDL_Rect expected;
+    SDL_UnionRect(&a, &b, &expected);
+    if(!same(a.union_with(b), expected)) {
+        fail("union_with", a, b);
+    }
+}
+
+void check_clip_line(const sdl::rect& a) {
+    auto one = random_point();
+    auto two = random_point();
+    int x1 = one.x, y1 = one.y, x2 = two.x, y2 = two.y;
+    int ex1 = one.x, ey1 = one.y, ex2 = two.x, ey2 = two.y;
+    auto expected = SDL_IntersectRectAndLine(&a, &ex1, &ey1, &ex2, &ey2) == SDL_TRUE;
+    auto result = a.clip_line(x1, y1, x2, y2);
+    if(result != expected || (result && (x1 != ex1 || y1 != ey1 || x2 != ex2 || y2 != ey2))) {
+        fail("clip_line", a, SDL_Rect{ one.x, one.y, two.x, two.y });
+    }
+}
+
+void check_enclose(const sdl::rect& clip) {
+    std::vector<SDL_Point> points(static_cast<std::size_t>(random_int(0, 8)));
+    for(auto&& p : points) {
+        p = random_point();
+    }
+
+    auto count = static_cast<int>(points.size());
+    SDL_Rect expected{ 0, 0, 0, 0 };
+    sdl::rect result;
+    auto hit = SDL_EnclosePoints(points.data(), count, &clip, &expected) == SDL_TRUE;
+    if(sdl::enclose(points.data(), points.size(), clip, result) != hit || (hit && !same(result, expected))) {
+        fail("enclose", clip, expected);
+    }
+
+    hit = SDL_EnclosePoints(points.data(), count, nullptr, &expected) == SDL_TRUE;
+    if(sdl::enclose(points.data(), points.size(), result) != hit || (hit && !same(result, expected))) {
+        fail("enclose without clip", result, expected);
+    }
+}
+
+// the batch versions have to agree with the single ones
+void check_batches(const sdl::rect& a) {
+    const std::size_t count = 16;
+    std::vector<SDL_Rect> rects(count);
+    std::vector<SDL_Point> lines(count * 2);
+    for(auto&& r : rects) {
+        r = random_rect();
+    }
+
+    for(auto&& p : lines) {
+        p = random_point();
+    }
+
+    bool hits[count];
+    SDL_Rect intersections[count];
+    std::size_t expected_hits = 0;
+    a.intersects(rects.data(), count, hits);
+    a.intersection(rects.data(), count, intersections);
+    for(std::size_t i = 0; i < count; ++i) {
+        auto hit = SDL_HasIntersection(&a, &rects[i]) == SDL_TRUE;
+        expected_hits += hit;
+        if(hits[i] != hit || (hit && !same(intersections[i], a.intersection(sdl::rect(rects[i].x, rects[i].y,
+                                                                                       rects[i].w, rects[i].h))))) {
+            fail("batch intersects", a, rects[i]);
+        }
+    }
+
+    if(a.intersects(rects.data(), count, hits) != expected_hits) {
+        fail("batch intersects count", a, a);
+    }
+
+    auto clipped = lines;
+    a.clip_lines(clipped.data(), count, hits);
+    for(std::size_t i = 0; i < count; ++i) {
+        auto one = lines[2 * i];
+        auto two = lines[2 * i + 1];
+        auto hit = SDL_IntersectRectAndLine(&a, &one.x, &one.y, &two.x, &two.y) == SDL_TRUE;
+        if(hits[i] != hit || (hit && (clipped[2 * i].x != one.x || clipped[2 * i].y != one.y ||
+                                      clipped[2 * i + 1].x != two.x || clipped[2 * i + 1].y != two.y))) {
+            fail("batch clip_lines", a, SDL_Rect{ lines[2 * i].x, lines[2 * i].y, lines[2 * i + 1].x, lines[2 * i + 1].y });
+        }
+    }
+}
+} // anonymous namespace
+
+int main() {
+    const int iterations = 200000;
+    for(int i = 0; i < iterations; ++i) {
+        auto a = random_rect();
+        auto b = random_rect();
+        check_intersects(a, b);
+        check_intersection(a, b);
+        check_union(a, b);
+        check_clip_line(a);
+        check_enclose(a);
+        if(i % 64 == 0) {
+            check_batches(a);
+        }
+    }
+
+    if(failures != 0) {
+        std::printf("%d mismatches against SDL\n", failures);
+        return 1;
+    }
+
+    std::printf("%d random cases matched SDL\n", iterations);
+    return 0;
+}
@@ -0,0 +1,229 @@
+// gum
+// Copyright (C) 2016 Rapptz
+
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+// checks the radix and frame coherent sorts behind command_buffer::sort against
+// std::stable_sort on random keys, including the fallback of the coherent sort
+
+#include <gum/detail/radix_sort.hpp>
+#include <gum/video/command_buffer.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+std::mt19937_64 rng(20160405);
+int failures = 0;
+
+int random_int(int low, int high) {
+    return std::uniform_int_distribution<int>(low, high)(rng);
+}
+
+// narrow keys give lots of ties, keys only differing in some bytes let the
+// radix sort skip passes
+uint64_t random_key(int kind) {
+    switch(kind) {
+    case 0:
+        return static_cast<uint64_t>(random_int(0, 7));
+    case 1:
+        return rng();
+    case 2:
+        return static_cast<uint64_t>(random_int(0, 255)) << 56 | static_cast<uint64_t>(random_int(0, 3)) << 16;
+    default:
+        return static_cast<uint64_t>(random_int(0, 1000));
+    }
+}
+
+void fail(const char* what, std::size_t size) {
+    if(++failures <= 20) {
+        std::printf("%s failed for %u entries\n", what, static_cast<unsigned>(size));
+    }
+}
+
+bool by_key(const sdl::detail::sort_entry& lhs, const sdl::detail::sort_entry& rhs) {
+    return lhs.key < rhs.key;
+}
+
+bool same(const std::vector<sdl::detail::sort_entry>& lhs, const std::vector<sdl::detail::sort_entry>& rhs) {
+    if(lhs.size() != rhs.size()) {
+        return false;
+    }
+
+    for(std::size_t i = 0; i < lhs.size(); ++i) {
+        if(lhs[i].key != rhs[i].key || lhs[i].index != rhs[i].index) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// the expected order is a stable sort of the entries in index order
+std::vector<sdl::detail::sort_entry> expected_order(const std::vector<sdl::detail::sort_entry>& entries) {
+    std::vector<sdl::detail::sort_entry> expected(entries.size());
+    for(auto&& entry : entries) {
+        expected[entry.index] = entry;
+    }
+    std::stable_sort(expected.begin(), expected.end(), by_key);
+    return expected;
+}
+
+void check_radix_sort(std::size_t size, int kind, std::vector<sdl::detail::sort_entry>& scratch) {
+    std::vector<sdl::detail::sort_entry> entries(size);
+    for(std::size_t i = 0; i < size; ++i) {
+        entries[i].key = random_key(kind);
+        entries[i].index = static_cast<uint32_t>(i);
+    }
+
+    // already sorted input takes a shortcut
+    if(random_int(0, 7) == 0) {
+        std::stable_sort(entries.begin(), entries.end(), by_key);
+        for(std::size_t i = 0; i < size; ++i) {
+            entries[i].index = static_cast<uint32_t>(i);
+        }
+    }
+
+    auto expected = expected_order(entries);
+    sdl::detail::radix_sort(entries, scratch);
+    if(!same(entries, expected)) {
+        fail("radix_sort", size);
+    }
+}
+
+// sorts, changes some of the keys and sorts again starting from the previous order.
+// Changing most of them goes over the budget of the insertion sort
+void check_coherent_sort(std::size_t size, int kind, std::vector<sdl::detail::sort_entry>& scratch) {
+    std::vector<sdl::detail::sort_entry> entries(size);
+    for(std::size_t i = 0; i < size; ++i) {
+        entries[i].key = random_key(kind);
+        entries[i].index = static_cast<uint32_t>(i);
+    }
+    sdl::detail::radix_sort(entries, scratch);
+
+    auto changes = random_int(0, 1) ? size / 50 + 1 : size;
+    for(std::size_t i = 0; i < changes && size != 0; ++i) {
+        entries[static_cast<std::size_t>(random_int(0, static_cast<int>(size) - 1))].key = random_key(kind);
+    }
+
+    // reversed keys are the worst case for the insertion sort
+    if(random_int(0, 7) == 0) {
+        for(auto&& entry : entries) {
+            entry.key = ~entry.key;
+        }
+    }
+
+    auto expected = expected_order(entries);
+    sdl::detail::coherent_sort(entries, scratch);
+    if(!same(entries, expected)) {
+        fail("coherent_sort", size);
+    }
+}
+
+struct recorded {
+    uint8_t layer;
+    uint16_t depth;
+    uint8_t red;
+};
+
+recorded random_command() {
+    return recorded{ static_cast<uint8_t>(random_int(0, 3)), static_cast<uint16_t>(random_int(0, 15)),
+                     static_cast<uint8_t>(random_int(0, 3)) };
+}
+
+void check_buffer_order(const sdl::command_buffer& buffer, const char* what) {
+    auto size = buffer.size();
+    std::vector<std::size_t> expected(size);
+    for(std::size_t i = 0; i < size; ++i) {
+        expected[i] = i;
+    }
+
+    auto* commands = buffer.data();
+    std::stable_sort(expected.begin(), expected.end(), [commands](std::size_t lhs, std::size_t rhs) {
+        return commands[lhs].key < commands[rhs].key;
+    });
+
+    for(std::size_t i = 0; i < size; ++i) {
+        if(&buffer.sorted(i) != commands + expected[i]) {
+            fail(what, size);
+            return;
+        }
+    }
+}
+
+// the same amount of commands as the last frame takes the frame coherent path,
+// which has to give the same order as sorting from scratch
+void check_command_buffer(bool depth_order) {
+    sdl::command_buffer buffer;
+    buffer.depth_order(depth_order);
+    std::vector<recorded> scene(static_cast<std::size_t>(random_int(0, 300)));
+    for(auto&& cmd : scene) {
+        cmd = random_command();
+    }
+
+    for(std::size_t frame = 0; frame < 20; ++frame) {
+        auto roll = random_int(0, 9);
+        if(roll == 0) {
+            // a different scene sorts from scratch
+            scene.resize(static_cast<std::size_t>(random_int(0, 300)));
+            for(auto&& cmd : scene) {
+                cmd = random_command();
+            }
+        }
+        else if(roll == 1) {
+            // everything moves, which goes over the budget of the insertion sort
+            for(auto&& cmd : scene) {
+                cmd = random_command();
+            }
+        }
+        else if(!scene.empty()) {
+            for(int i = random_int(0, 4); i > 0; --i) {
+                scene[static_cast<std::size_t>(random_int(0, static_cast<int>(scene.size()) - 1))] = random_command();
+            }
+        }
+
+        for(auto&& cmd : scene) {
+            buffer.fill_rect(SDL_Rect{ 0, 0, 1, 1 }, SDL_Color{ cmd.red, 0, 0, 255 }, cmd.layer, cmd.depth);
+        }
+        buffer.sort();
+        check_buffer_order(buffer, depth_order ? "command_buffer::sort in depth order" : "command_buffer::sort");
+        buffer.clear();
+    }
+}
+} // anonymous namespace
+
+int main() {
+    const int iterations = 2000;
+    std::vector<sdl::detail::sort_entry> scratch;
+    for(int i = 0; i < iterations; ++i) {
+        auto size = static_cast<std::size_t>(random_int(0, 1) ? random_int(0, 40) : random_int(0, 3000));
+        auto kind = random_int(0, 3);
+        check_radix_sort(size, kind, scratch);
+        check_coherent_sort(size, kind, scratch);
+        if(i % 8 == 0) {
+            check_command_buffer(i % 16 == 0);
+        }
+    }
+
+    if(failures != 0) {
+        std::printf("%d mismatches against std::stable_sort\n", failures);
+        return 1;
+    }
+
+    std::printf("%d random cases matched std::stable_sort\n", iterations);
+    return 0;
+}